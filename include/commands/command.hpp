@@ -1,6 +1,9 @@
 #pragma once
 #include <functional>
+#include <stdexcept>
 #include <string>
+#include <tuple>
+#include <vector>
 
 namespace cas {
     class Engine;
@@ -10,6 +13,66 @@ namespace cas::commands {
     template<typename T>
     T parseArg(const std::string& arg);
 
+    template<typename T>
+    struct is_pointer_vector : std::false_type {};
+
+    template<typename T>
+    struct is_pointer_vector<std::vector<T*>> : std::true_type {};
+
+    // the last parameter of a command can take all remaining arguments
+    template<typename T>
+    struct Variadic {
+        using value_type = T;
+
+        std::vector<T> values;
+    };
+
+    template<typename T>
+    struct is_variadic : std::false_type {};
+
+    template<typename T>
+    struct is_variadic<Variadic<T>> : std::true_type {};
+
+    template<typename T>
+    inline void deleteArg(T& arg) {
+        if constexpr (std::is_pointer<T>::value) {
+            delete arg;
+        }
+        else if constexpr (is_pointer_vector<T>::value) {
+            for (auto element : arg) {
+                delete element;
+            }
+        }
+        else if constexpr (is_variadic<T>::value) {
+            for (auto& value : arg.values) {
+                deleteArg(value);
+            }
+        }
+    }
+
+    // owns a parsed argument until the command is finished. The argument is also deleted if a later argument can not
+    // be parsed or the command throws, e.g. because it was cancelled
+    template<typename T>
+    struct ArgOwner {
+        T value;
+
+        inline ArgOwner(T&& value)
+            : value(std::move(value)) {
+        }
+
+        inline ArgOwner(ArgOwner&& other)
+            : value(std::move(other.value)) {
+            if constexpr (std::is_pointer<T>::value || is_pointer_vector<T>::value || is_variadic<T>::value)
+                other.value = T{};
+        }
+
+        ArgOwner(const ArgOwner& other) = delete;
+
+        inline ~ArgOwner() {
+            deleteArg(value);
+        }
+    };
+
     template<typename TRes, typename... TArgs>
     using CommandFunctor = std::function<TRes(Engine*, TArgs...)>;
 
@@ -18,28 +81,31 @@ namespace cas::commands {
       protected:
         CommandFunctor<TRes, TArgs...> callback;
 
-        template<std::size_t... I>
-        inline TRes executeWithArgs(Engine* engine, const std::vector<std::string>& argV, std::index_sequence<I...>) const {
-            std::tuple<TArgs...> args = std::make_tuple(std::move(parseArg<TArgs>(argV[I]))...);
-
-            TRes result = callback(engine, std::get<I>(args)...);
-            deleteArgs(std::get<I>(args)...);
-            return result;
-        }
+        template<typename T>
+        inline static T parseArgAt(const std::vector<std::string>& argV, std::size_t index) {
+            if constexpr (is_variadic<T>::value) {
+                T result;
+                for (std::size_t i = index; i < argV.size(); i++) {
+                    result.values.push_back(parseArg<typename T::value_type>(argV[i]));
+                }
 
-        template<typename T1, typename... T>
-        inline static void deleteArgs(T1 arg, T... args) {
-            if constexpr (std::is_pointer<T1>::value) {
-                delete arg;
+                return result;
+            }
+            else {
+                return parseArg<T>(argV[index]);
             }
-            deleteArgs(args...);
         }
 
-        template<typename T1>
-        inline static void deleteArgs(T1 arg) {
-            if constexpr(std::is_pointer<T1>::value) {
-                delete arg;
-            }
+        template<std::size_t... I>
+        inline TRes executeWithArgs(Engine* engine, const std::vector<std::string>& argV, std::index_sequence<I...>) const {
+            constexpr std::size_t requiredArgs = sizeof...(TArgs) - (is_variadic<std::tuple_element_t<sizeof...(TArgs) - 1, std::tuple<TArgs...>>>::value ? 1 : 0);
+            if (argV.size() < requiredArgs)
+                throw std::runtime_error("The command expects " + std::to_string(requiredArgs) + " arguments");
+
+            // the elements of a braced list are parsed in order
+            std::tuple<ArgOwner<TArgs>...> args{ArgOwner<TArgs>(parseArgAt<TArgs>(argV, I))...};
+
+            return callback(engine, std::get<I>(args).value...);
         }
 
       public:
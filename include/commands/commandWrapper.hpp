@@ -1,10 +1,15 @@
 #pragma once
 #include "command.hpp"
 #include "commandCallback.hpp"
+#include "io/resultCache.hpp"
 
 #include <mathlib/mathlib.hpp>
 
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
 
 namespace cas {
     class Engine;
@@ -14,35 +19,126 @@ namespace cas::commands {
     struct CommandWrapper {
       protected:
         std::function<void(Engine*, const std::vector<std::string>&)> functional;
+        bool cached = false;
 
         static void saveAns(Engine* engine, cas::math::Expression* result);
 
+        // nullptr if the cache of the engine is disabled
+        static ResultCache* getResultCache(Engine* engine);
+
+        // removes the whitespaces around the arguments. The cache key and the command use the same arguments, so
+        // arguments that only differ in whitespaces give the same result
+        static std::vector<std::string> normalizeArguments(const std::vector<std::string>& argV);
+
+        // parameters that take a single expression or variable can be passed a list in batch commands
+        template<typename... TArgs>
+        inline static std::vector<bool> getBatchArguments() {
+            return {(std::is_same_v<TArgs, cas::math::Expression*> || std::is_same_v<TArgs, cas::math::ExprRef> || std::is_same_v<TArgs, cas::math::Variable*>)...};
+        }
+
+        // the arguments for every element of a batch command, or nothing if no argument is a list. A list is written
+        // like [a, b, ...], all lists of one command must have the same length and the other arguments are used for
+        // every element, so D[[x^2, x*y], x] calculates two derivatives. An empty list gives an empty batch
+        static std::optional<std::vector<std::vector<std::string>>> expandBatch(const std::vector<std::string>& argV, const std::vector<bool>& batchArguments);
+
+        // calls body for every element on the thread pool. The elements see the variables of the calling thread
+        static void runBatch(size_t count, const std::function<void(size_t)>& body);
+
+        static void printExpressionList(const std::vector<std::unique_ptr<cas::math::Expression>>& expressions);
+
+        // prints the output of every element after a line "Element <i>:", so the client can tell the outputs of the
+        // elements apart. An empty batch is printed as []
+        static void printElementOutputs(size_t count, const std::function<void(size_t)>& printElement);
+
       public:
         inline CommandWrapper() {
             functional = [](Engine* engine, const std::vector<std::string>& argV) {};
         }
 
+        // the results of cached commands are looked up in the result cache of the engine before the command is executed.
+        // Only commands whose result depends on nothing but their arguments can be cached. Cached commands can also be
+        // executed for a list of arguments, see expandBatch.
         template<typename TRes, typename... TArgs>
-        inline CommandWrapper(const Command<TRes, TArgs...>& command, CommandCallback<TRes> callback = DefaultCallback<TRes>) {
-            functional = [command, callback](Engine* engine, const std::vector<std::string>& argV) {
+        inline CommandWrapper(const std::string& alias, const Command<TRes, TArgs...>& command, CommandCallback<TRes> callback = DefaultCallback<TRes>,
+                              bool cached = false)
+            : cached(cached) {
+            auto executeCached = [alias, command, cached](Engine* engine, const std::vector<std::string>& argV) {
+                ResultCache* cache = cached ? getResultCache(engine) : nullptr;
+                if (cache == nullptr)
+                    return command.execute(engine, argV);
+
+                ResultCache::Key key = ResultCache::makeKey(alias, argV);
+                std::optional<TRes> cachedResult = cache->find<TRes>(key);
+                if (cachedResult)
+                    return *cachedResult;
+
                 TRes result = command.execute(engine, argV);
+                cache->insert(std::move(key), result);
+                return result;
+            };
+
+            functional = [executeCached, callback, cached](Engine* engine, const std::vector<std::string>& argV) {
+                const std::vector<std::string> args = normalizeArguments(argV);
+                const auto batch = cached ? expandBatch(args, getBatchArguments<TArgs...>()) : std::nullopt;
+                if (!batch) {
+                    callback(executeCached(engine, args));
+                    return;
+                }
+
+                std::vector<std::optional<TRes>> results(batch->size());
+                runBatch(batch->size(), [&](size_t i) { results[i] = executeCached(engine, (*batch)[i]); });
 
-                callback(result);
+                printElementOutputs(results.size(), [&](size_t i) { callback(*results[i]); });
             };
         }
 
         template<typename... TArgs>
-        inline CommandWrapper(const Command<cas::math::Expression*, TArgs...>& command, CommandCallback<cas::math::Expression*> callback = DefaultCallback<cas::math::Expression*>) {
-            functional = [command, callback](Engine* engine, const std::vector<std::string>& argV) {
+        inline CommandWrapper(const std::string& alias, const Command<cas::math::Expression*, TArgs...>& command,
+                              CommandCallback<cas::math::Expression*> callback = DefaultCallback<cas::math::Expression*>, bool cached = false)
+            : cached(cached) {
+            // the result belongs to the caller
+            auto executeCached = [alias, command, cached](Engine* engine, const std::vector<std::string>& argV) {
+                ResultCache* cache = cached ? getResultCache(engine) : nullptr;
+                if (cache == nullptr)
+                    return command.execute(engine, argV);
+
+                // the cache keeps its own copy
+                ResultCache::Key key = ResultCache::makeKey(alias, argV);
+                std::optional<cas::math::FrozenExpression> cachedResult = cache->find<cas::math::FrozenExpression>(key);
+                if (cachedResult)
+                    return cachedResult->thaw();
+
                 cas::math::Expression* expr = command.execute(engine, argV);
+                cache->insert(std::move(key), cas::math::FrozenExpression::copyOf(expr));
+                return expr;
+            };
 
-                callback(expr);
-                saveAns(engine, expr);
+            functional = [executeCached, callback, cached](Engine* engine, const std::vector<std::string>& argV) {
+                const std::vector<std::string> args = normalizeArguments(argV);
+                const auto batch = cached ? expandBatch(args, getBatchArguments<TArgs...>()) : std::nullopt;
+                if (!batch) {
+                    cas::math::Expression* expr = executeCached(engine, args);
+
+                    callback(expr);
+                    saveAns(engine, expr);
+                    return;
+                }
+
+                // the results of a batch are printed as a list, ans is not changed
+                std::vector<std::unique_ptr<cas::math::Expression>> results(batch->size());
+                runBatch(batch->size(), [&](size_t i) { results[i].reset(executeCached(engine, (*batch)[i])); });
+
+                printExpressionList(results);
             };
         }
 
         inline void executeCommand(Engine* engine, const std::vector<std::string>& argV) const {
             functional(engine, argV);
         }
+
+        // cached commands have no side effects, so they can run concurrently
+        inline bool isCached() const {
+            return cached;
+        }
     };
 } // namespace cas::commands
\ No newline at end of file
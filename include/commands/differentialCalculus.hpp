@@ -4,39 +4,68 @@
 
 #include <mathlib/mathlib.hpp>
 
+#include <sstream>
+
 using namespace cas::math;
 
 namespace cas {
     class Engine;
 
     namespace commands {
-        static const Command<Expression*, Expression*, Variable*> differentiate = Command<Expression*, Expression*, Variable*>(
-            [](Engine* engine, Expression* expr, Variable* var) {
+        static const Command<Expression*, ExprRef, Variable*> differentiate = Command<Expression*, ExprRef, Variable*>(
+            [](Engine* engine, ExprRef expr, Variable* var) {
                 return expr->differentiate(var);
             });
 
-        static const Command<Expression*, Expression*> differential = Command<Expression*, Expression*>(
-            [](Engine* engine, Expression* expr) {
-                std::set<Variable> vars = expr->getVariables();
-                Expression* result = new Number(0);
+        static const Command<Expression*, ExprRef> differential = Command<Expression*, ExprRef>(
+            [](Engine* engine, ExprRef expr) {
+                const std::set<Variable> varSet = expr->getVariables();
+                const std::vector<Variable> vars(varSet.begin(), varSet.end());
+                if (vars.size() == 0)
+                    return static_cast<Expression*>(new Number(0));
+
+                // the partial derivatives are calculated in parallel, in the same form as by the D command
+                std::vector<Expression*> partials = differentiateAll(expr.get(), vars);
+
+                Expression* result = new Multiplication(partials[0], new Differential(vars[0].getSymbol()));
+                for (size_t i = 1; i < vars.size(); i++) {
+                    Expression* d = new Multiplication(partials[i], new Differential(vars[i].getSymbol()));
+                    result = new Addition(result, d);
+                }
 
-                if (vars.size() > 0) {
-                    delete result;
+                return result;
+            });
 
-                    auto it = vars.begin();
-                    result = new Multiplication(expr->differentiate(&(*it)), new Differential(it->getSymbol()));
-                    it++;
+        static const Command<std::string, std::vector<Expression*>, std::vector<Variable>> jacobianCommand = Command<std::string, std::vector<Expression*>, std::vector<Variable>>(
+            [](Engine* engine, std::vector<Expression*> expressions, std::vector<Variable> vars) {
+                std::vector<Expression*> entries = jacobian(expressions, vars, true);
 
-                    while (it != vars.end()) {
-                        Expression* d = new Multiplication(expr->differentiate(&(*it)), new Differential(it->getSymbol()));
-                        Expression* tmp = new Addition(result, d);
+                std::stringstream ss;
+                for (size_t i = 0; i < expressions.size(); i++) {
+                    if (i > 0)
+                        ss << std::endl;
 
-                        result = tmp;
-                        it++;
+                    ss << "[";
+                    for (size_t j = 0; j < vars.size(); j++) {
+                        ss << (j > 0 ? ", " : "") << entries[i * vars.size() + j]->toString();
                     }
+                    ss << "]";
                 }
 
-                return result;
+                for (Expression* entry : entries) {
+                    delete entry;
+                }
+
+                return ss.str();
+            });
+
+        static const Command<Expression*, ExprRef, Variable*, Expression*, Expression*> series = Command<Expression*, ExprRef, Variable*, Expression*, Expression*>(
+            [](Engine* engine, ExprRef expr, Variable* var, Expression* x0, Expression* order) {
+                const double n = order->getValue().realValue;
+                if (n < 0 || std::floor(n) != n)
+                    throw std::runtime_error("The order of the series has to be a non negative integer");
+
+                return cas::math::series(expr.get(), *var, x0->getValue().realValue, static_cast<size_t>(n));
             });
     } // namespace commands
 } // namespace cas
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "command.hpp"
+
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+
+namespace cas {
+    class Engine;
+
+    namespace commands {
+        static const Command<std::vector<PolynomialRoot>, ExprRef, Variable*> roots = Command<std::vector<PolynomialRoot>, ExprRef, Variable*>(
+            [](Engine* engine, ExprRef expr, Variable* var) {
+                return cas::math::roots(expr.get(), *var);
+            });
+
+        static const Command<std::vector<NewtonSolution>, std::vector<Expression*>, std::vector<Variable>, std::vector<std::vector<double>>> nsolve = Command<std::vector<NewtonSolution>, std::vector<Expression*>, std::vector<Variable>, std::vector<std::vector<double>>>(
+            [](Engine* engine, std::vector<Expression*> equations, std::vector<Variable> variables, std::vector<std::vector<double>> starts) {
+                return cas::math::nsolve(equations, variables, starts);
+            });
+    } // namespace commands
+} // namespace cas
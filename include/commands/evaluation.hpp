@@ -0,0 +1,35 @@
+#pragma once
+
+#include "command.hpp"
+#include "io/variableGraph.hpp"
+
+#include <mathlib/mathlib.hpp>
+
+#include <memory>
+#include <set>
+
+using namespace cas::math;
+
+namespace cas {
+    class Engine;
+
+    namespace commands {
+        // files ending with .bin are written in the binary format, all others as CSV. The axes are swept even if
+        // variables with the same names are defined, only the other variables are replaced by their values
+        static const Command<std::string, FrozenExpression, VariableSymbol, Variadic<SweepAxis>> sweepCommand = Command<std::string, FrozenExpression, VariableSymbol, Variadic<SweepAxis>>(
+            [](Engine* engine, FrozenExpression expr, VariableSymbol path, Variadic<SweepAxis> axes) {
+                const SweepFormat format = path.ends_with(".bin") ? SweepFormat::Binary : SweepFormat::Csv;
+
+                std::set<VariableSymbol> axisSymbols;
+                for (const SweepAxis& axis : axes.values) {
+                    axisSymbols.insert(axis.variable.getSymbol());
+                }
+
+                VariableGraph* variables = VariableGraph::getCurrent();
+                const std::unique_ptr<Expression> substituted(variables != nullptr ? variables->substitute(expr.get(), axisSymbols) : expr.thaw());
+
+                const size_t points = sweep(substituted.get(), axes.values, path, format);
+                return "wrote " + std::to_string(points) + " points to " + path;
+            });
+    } // namespace commands
+} // namespace cas
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "command.hpp"
+
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+
+namespace cas {
+    class Engine;
+
+    namespace commands {
+        static const Command<IntegrationResult, ExprRef, Variable*, Expression*, Expression*> integrate = Command<IntegrationResult, ExprRef, Variable*, Expression*, Expression*>(
+            [](Engine* engine, ExprRef expr, Variable* var, Expression* a, Expression* b) {
+                return cas::math::integrate(expr.get(), *var, a->getValue().realValue, b->getValue().realValue);
+            });
+    } // namespace commands
+} // namespace cas
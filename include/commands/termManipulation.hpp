@@ -10,9 +10,19 @@ namespace cas {
     class Engine;
 
     namespace commands {
-        static const Command<Expression*, Expression*> simplify = Command<Expression*, Expression*>(
-            [](Engine* engine, Expression* expr) {
+        static const Command<Expression*, ExprRef> simplify = Command<Expression*, ExprRef>(
+            [](Engine* engine, ExprRef expr) {
                 return expr->simplify();
             });
+
+        static const Command<Expression*, ExprRef> cancel = Command<Expression*, ExprRef>(
+            [](Engine* engine, ExprRef expr) {
+                return cas::math::cancel(expr.get());
+            });
+
+        static const Command<Expression*, ExprRef, ExprRef> gcd = Command<Expression*, ExprRef, ExprRef>(
+            [](Engine* engine, ExprRef left, ExprRef right) {
+                return cas::math::polynomialGcd(left.get(), right.get());
+            });
     }
 } // namespace cas
\ No newline at end of file
@@ -8,12 +8,16 @@ using namespace cas::math;
 namespace cas::commands {
     Command<ExpressionMatch, Expression*, Expression*> matchCommand = Command<ExpressionMatch, Expression*, Expression*>(
         [](Engine* engine, Expression* expr, Expression* pattern) {
-            return ExpressionMatcher::match(expr, pattern);
+            ExpressionMatch match = ExpressionMatcher::match(expr, pattern);
+            match.detach();
+            return match;
         });
 
     Command<ExpressionMatch, Expression*, Expression*> matchRecurseCommand = Command<ExpressionMatch, Expression*, Expression*>(
         [](Engine* engine, Expression* expr, Expression* pattern) {
-            return ExpressionMatcher::match(expr, pattern, true);
+            ExpressionMatch match = ExpressionMatcher::match(expr, pattern, true);
+            match.detach();
+            return match;
         });
 
     Command<Expression*, Expression*, Expression*, Expression*> substituteCommand = Command<Expression*, Expression*, Expression*, Expression*>(
@@ -23,6 +27,11 @@ namespace cas::commands {
 
     Command<std::vector<ExpressionMatch>, Expression*, Expression*> matchAllCommand = Command<std::vector<ExpressionMatch>, Expression*, Expression*>(
         [](Engine* engine, Expression* expr, Expression* pattern) {
-            return ExpressionMatcher::matchAll(expr, pattern);
+            // the matched nodes are copied, because the arguments are deleted after the command
+            std::vector<ExpressionMatch> matches = ExpressionMatcher::matchAll(expr, pattern);
+            for (ExpressionMatch& match : matches) {
+                match.detach();
+            }
+            return matches;
         });
 } // namespace cas::commands
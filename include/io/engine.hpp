@@ -1,9 +1,19 @@
 #pragma once
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
 #include "commands/commandWrapper.hpp"
+#include "io/ioStream.hpp"
+#include "io/resultCache.hpp"
+#include "io/speculator.hpp"
+#include "io/variableGraph.hpp"
 
 #include <mathlib/mathlib.hpp>
 
@@ -18,27 +28,127 @@ namespace cas {
             static CommandCallback<Expression*> printExpressionCallback;
             static CommandCallback<ExpressionMatch> printExpressionMatchCallback;
             static CommandCallback<std::vector<ExpressionMatch>> printExpressionMatchesCallback;
+            static CommandCallback<std::vector<PolynomialRoot>> printRootsCallback;
+            static CommandCallback<std::vector<NewtonSolution>> printNewtonSolutionsCallback;
+            static CommandCallback<IntegrationResult> printIntegrationResultCallback;
         };
 
         std::unordered_map<std::string, CommandWrapper> commands;
-        std::unordered_map<cas::math::VariableSymbol, cas::math::Expression*> vars;
-        bool running = false;
+        VariableGraph variables;
+        std::atomic<bool> running = true;
+        bool batchMode = false;
+        std::atomic<size_t> commandCounter = 0;
+
+        // independent commands can finish in any order, ans is the result of the last finished one
+        mutable std::mutex ansMutex;
         Expression* ans = nullptr;
 
+        // commands with a timeout run on the executor while the calling thread waits. Without a shared executor the
+        // engine creates its own with one thread
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(0);
+        std::once_flag executorCreated;
+        std::unique_ptr<ThreadPool> ownExecutor;
+        ThreadPool* executor = nullptr;
+
+        // the tokens of all running commands, independent commands can run concurrently
+        std::mutex tokenMutex;
+        std::list<CancellationToken> runningTokens;
+
+        // commands that did not stop after they were cancelled. Their threads still use the engine, which rejects all
+        // further commands. Guarded by the token mutex
+        std::atomic<bool> poisoned = false;
+        struct AbandonedCommand {
+            std::string alias;
+            std::future<void> result;
+        };
+        std::vector<AbandonedCommand> abandonedCommands;
+
+        // the limits command can change the limits while other commands or the speculation read them
+        mutable std::mutex limitsMutex;
+        ResourceLimits limits;
+
+        ResultCache resultCache;
+
+        // declared last, so the background thread is stopped before the variables and the cache are destroyed
+        std::unique_ptr<Speculator> speculator;
+
         void setupCommands();
 
         void handleVariableInput(const std::string& input);
 
+        // runs the command on the calling thread with the given token and a new resource budget
+        void executeCommand(const io::IOStream::Command& command, const CancellationToken& token);
+
         friend struct cas::commands::CommandWrapper;
+        friend class Speculator;
 
       public:
         Engine();
+        Engine(const Engine& other) = delete;
+        ~Engine();
 
+        // the results of cached commands are stored in the result cache. Only commands without side effects can be cached
         template<typename TRes, typename... TArgs>
-        inline void addCommand(const std::string& alias, const Command<TRes, TArgs...>& command, CommandCallback<TRes>& callback = DefaultCallback<TRes>) {
-            commands[alias] = CommandWrapper(command, callback);
+        inline void addCommand(const std::string& alias, const Command<TRes, TArgs...>& command, CommandCallback<TRes>& callback = DefaultCallback<TRes>,
+                               bool cached = false) {
+            commands[alias] = CommandWrapper(alias, command, callback, cached);
         }
 
-        void run();
+        // executes a single command and reports errors. Returns false if the command failed. Independent commands can
+        // be executed concurrently from several threads, all other commands need the engine for themselves
+        bool execute(const io::IOStream::Command& command);
+
+        // true if the command has no side effects and only depends on its arguments and the variables
+        bool isIndependent(const io::IOStream::Command& command) const;
+
+        // in batch mode errors are reported with the number of the failed command
+        void setBatchMode(bool enabled);
+
+        // false after the exit command was executed
+        bool isRunning() const;
+
+        // commands running longer than the timeout are cancelled. A timeout of zero disables it. A cancelled command that
+        // does not stop within a second is abandoned and poisons the engine
+        void setTimeout(std::chrono::milliseconds timeout);
+        std::chrono::milliseconds getTimeout() const;
+
+        // the executor runs the commands with a timeout. It needs a thread for every command that runs at the same
+        // time and can be shared by several engines, e.g. the sessions of a server. nullptr restores the executor of
+        // the engine. Must not be changed while commands are running
+        void setExecutor(ThreadPool* executor);
+
+        // limits for the expressions created by a single command. Every command uses the limits that were set when it
+        // started
+        void setLimits(const ResourceLimits& limits);
+        ResourceLimits getLimits() const;
+
+        // the capacity is the approximate memory used by the cached results in bytes, zero disables the cache
+        void setCacheCapacity(size_t bytes);
+        ResultCache::Statistics getCacheStatistics() const;
+
+        // precomputes the results of likely commands in the background after every assignment
+        void setSpeculation(bool enabled);
+        bool isSpeculating() const;
+
+        // writes the variables and ans into a binary snapshot
+        size_t saveSnapshot(const std::string& path) const;
+        // replaces the variables stored in the snapshot and ans. Nothing is changed if an expression can not be loaded or
+        // the definitions depend on themselves. Returns the number of loaded expressions
+        size_t loadSnapshot(const std::string& path);
+
+        // cancels all running commands. Can be called from any thread
+        void cancel();
+
+        // true after a cancelled command was abandoned. A poisoned engine stops and rejects all commands
+        bool isPoisoned() const;
+
+        // an abandoned command still uses the engine and the thread of its executor, so neither can be destroyed. Reports
+        // the commands on stderr, flushes the output and the log and exits the process if such a command is still
+        // running. Called by the destructor and by the owners of the executors, a server keeps poisoned engines alive
+        // until it stops
+        void exitIfAbandoned();
+
+        // processes commands until the input ends or exit is called. Returns 0 if all commands succeeded
+        int run();
     };
 } // namespace cas
\ No newline at end of file
@@ -1,14 +1,22 @@
 #pragma once
 #include <istream>
+#include <memory>
+#include <ostream>
 #include <vector>
-#include <fstream>
+
+#include "io/logger.hpp"
 
 namespace cas::io {
     class IOStream {
       protected:
         static void removeWhitespaces(std::string& str);
 
-        static std::ofstream log;
+        static std::istream* input;
+        static thread_local std::ostream* output;
+        static std::unique_ptr<Logger> logger;
+        static bool prompt;
+
+        static void writeLog(const std::string& str, const std::string& suffix = "", LogLevel level = LogLevel::Info);
         
       public:
         struct Command {
@@ -16,12 +24,37 @@ namespace cas::io {
             std::vector<std::string> args;
         };
 
-        static Command readCommand();
+        // reads the next non empty command. Returns false if the end of the input is reached
+        static bool readCommand(Command& command);
+
+        static Command parseCommand(const std::string& text);
+
+        // returns false if the text contains only whitespaces
+        static bool isEmptyCommand(const std::string& text);
+
+        // splits at the commas that are not enclosed in brackets
+        static std::vector<std::string> splitArguments(const std::string& str);
 
         static std::string readLine(char delimiter = '\n');
 
         static void writeLine(const std::string& str);
 
         static void write(const std::string& str);
+
+        static void writeError(const std::string& str);
+
+        static void setInput(std::istream& stream);
+
+        // redirects the output of the calling thread, e.g. to the connection of a server session. nullptr restores stdout
+        static void setOutput(std::ostream* stream);
+        static std::ostream* getOutput();
+
+        // the prompt is written before a command is read. It is disabled in batch mode
+        static void setPrompt(bool enabled);
+
+        // an empty path disables the log. Must not be called while other threads write
+        static void setLog(const LoggerOptions& options);
+
+        static void flush();
     };
-} // namespace cas::io
\ No newline at end of file
+} // namespace cas::io
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <mathlib/mathlib.hpp>
+
+namespace cas::io {
+    // records below the level of the logger are discarded
+    enum class LogLevel {
+        Info,
+        Error
+    };
+
+    struct LoggerOptions {
+        std::string path = "commandLog.log";
+        LogLevel level = LogLevel::Info;
+
+        // the file is rotated to path.1, path.2, ... when it grows larger than maxFileSize. Zero disables the rotation
+        size_t maxFileSize = 0;
+        size_t maxFiles = 3;
+
+        // number of records that can wait to be written
+        size_t capacity = 8192;
+    };
+
+    // writes the records on a background thread. Logging never blocks the caller, records are dropped if the buffer is
+    // full and the number of dropped records is written to the log.
+    class Logger {
+      protected:
+        LoggerOptions options;
+
+        cas::math::RingBuffer<std::string> buffer;
+        std::atomic<size_t> accepted = 0;
+        std::atomic<size_t> processed = 0;
+        std::atomic<size_t> dropped = 0;
+        std::atomic<bool> stopping = false;
+
+        // incremented after every push and by the destructor to wake up the worker
+        std::atomic<size_t> wakeups = 0;
+
+        // only used by the worker
+        std::ofstream file;
+        size_t fileSize = 0;
+
+        std::thread worker;
+
+        void workerLoop();
+        void writeRecord(const std::string& record);
+        void rotate();
+
+      public:
+        Logger(const LoggerOptions& options);
+        Logger(const Logger& other) = delete;
+        ~Logger();
+
+        bool isEnabled(LogLevel level) const;
+
+        void log(LogLevel level, std::string&& record);
+
+        // waits until all records logged before are written to the file
+        void flush();
+    };
+} // namespace cas::io
@@ -0,0 +1,61 @@
+#pragma once
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <mathlib/mathlib.hpp>
+
+namespace cas::io {
+    // least recently used cache of parsed expressions. The cached expressions are frozen and shared, the commands work on
+    // copies.
+    class ParseCache {
+      public:
+        struct Statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t entries = 0;
+            size_t bytes = 0;
+            size_t capacity = 0;
+        };
+
+      protected:
+        struct Entry {
+            std::string text;
+            math::FrozenExpression expr;
+            size_t bytes;
+        };
+
+        mutable std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+        size_t capacity;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+
+        void evict(size_t capacity);
+
+      public:
+        static constexpr size_t defaultCapacity = 16 * 1024 * 1024;
+
+        // the capacity is the approximate memory used by the entries in bytes. A capacity of zero disables the cache
+        ParseCache(size_t capacity = defaultCapacity);
+
+        // cache used by the commands of all engines
+        static ParseCache& shared();
+
+        // returns the cached expression or parses the text. Throws if the text is not a valid expression
+        math::FrozenExpression parse(const std::string& text);
+
+        // returns a new copy of the parsed expression
+        math::Expression* parseCopy(const std::string& text);
+
+        void setCapacity(size_t capacity);
+        void clear();
+
+        Statistics getStatistics() const;
+    };
+} // namespace cas::io
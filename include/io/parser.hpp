@@ -24,6 +24,13 @@ namespace cas::io {
             static std::string getBracketContent(const std::string& str, std::string::const_iterator it);
 
         public:
+            // inputs of at least parallelThreshold characters are parsed with parseParallel
             static Expression* parse(const std::string& str);
+
+            // splits the top level sum in one scan and parses the summands on the thread pool. The result is the same
+            // tree as the sequential parser creates
+            static Expression* parseParallel(const std::string& str);
+
+            static constexpr size_t parallelThreshold = 64 * 1024;
     };
 }
\ No newline at end of file
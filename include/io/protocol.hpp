@@ -0,0 +1,61 @@
+#pragma once
+#include "io/engine.hpp"
+
+#include <mathlib/mathlib.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace cas::io {
+    // machine readable protocol on a pair of streams. Every request is one line "<id> <command>", every response is
+    // one line "<id> ok <output>" or "<id> error <message>" where newlines and backslashes of the output are escaped
+    // as \n and \\. Independent commands are executed concurrently and answered as soon as they are finished, all
+    // other commands wait for the running requests and are executed alone, so they see all earlier requests.
+    class Protocol {
+      protected:
+        struct Request {
+            std::string id;
+            IOStream::Command command;
+        };
+
+        Engine& engine;
+        std::istream& input;
+        std::ostream& output;
+
+        std::mutex outputMutex;
+
+        std::mutex mutex;
+        std::condition_variable requestFinished;
+        size_t runningRequests = 0;
+
+        std::atomic<size_t> failedRequests = 0;
+
+        // runs the commands with a timeout, every worker and the reading thread wait for at most one command
+        cas::math::ThreadPool timeoutExecutor;
+        cas::math::ThreadPool workers;
+
+        // returns false and answers the request if the line contains no command
+        bool parseRequest(const std::string& line, Request& request);
+
+        void process(const Request& request);
+        void respond(const std::string& id, bool succeeded, const std::string& text);
+
+        // blocks until all independent requests are answered
+        void waitForRequests();
+
+        static std::string escape(const std::string& str);
+
+      public:
+        Protocol(Engine& engine, std::istream& input, std::ostream& output, size_t workerCount = std::thread::hardware_concurrency());
+        Protocol(const Protocol& other) = delete;
+        ~Protocol();
+
+        // processes requests until the input ends or exit is called. Returns 0 if all requests succeeded
+        int run();
+    };
+} // namespace cas::io
@@ -0,0 +1,118 @@
+#pragma once
+#include <any>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mathlib/mathlib.hpp>
+
+namespace cas {
+    // least recently used cache for the results of commands without side effects. The arguments are parsed and
+    // compared structurally, so different spellings of the same expression share an entry.
+    class ResultCache {
+      public:
+        struct Key {
+            std::string alias;
+            // arguments that can not be parsed as an expression are compared as text
+            std::vector<std::string> texts;
+            std::vector<math::FrozenExpression> expressions;
+            size_t hash = 0;
+
+            bool operator==(const Key& other) const;
+        };
+
+        struct Statistics {
+            size_t hits = 0;
+            size_t misses = 0;
+            size_t evictions = 0;
+            size_t entries = 0;
+            size_t bytes = 0;
+            size_t capacity = 0;
+        };
+
+      protected:
+        struct Entry {
+            Key key;
+            std::any value;
+            size_t bytes;
+        };
+
+        mutable std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+
+        size_t capacity;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t evictions = 0;
+
+        const std::any* lookup(const Key& key);
+        void store(Key&& key, std::any&& value, size_t size);
+        void evictLast();
+
+        static size_t estimateSize(const Key& key);
+
+      public:
+        static constexpr size_t defaultCapacity = 64 * 1024 * 1024;
+
+        // the capacity is the approximate memory used by the entries in bytes. A capacity of zero disables the cache
+        ResultCache(size_t capacity = defaultCapacity);
+
+        // the arguments have to be the same text the command is executed with, see CommandWrapper::normalizeArguments
+        static Key makeKey(const std::string& alias, const std::vector<std::string>& args);
+
+        template<typename T>
+        inline std::optional<T> find(const Key& key) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            const std::any* value = lookup(key);
+            if (value == nullptr)
+                return std::nullopt;
+
+            return std::any_cast<const T&>(*value);
+        }
+
+        template<typename T>
+        inline void insert(Key&& key, const T& value) {
+            const size_t size = estimateSize(key) + estimateSize(value);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            store(std::move(key), std::any(value), size);
+        }
+
+        // does not count as hit or miss and does not change the order of the entries
+        bool contains(const Key& key) const;
+
+        void setCapacity(size_t capacity);
+        bool isEnabled() const;
+        void clear();
+
+        Statistics getStatistics() const;
+
+        // approximate memory used by a result
+        static size_t estimateSize(const std::string& value);
+        static size_t estimateSize(const math::FrozenExpression& value);
+        static size_t estimateSize(const math::ExpressionMatch& value);
+        static size_t estimateSize(const math::NewtonSolution& value);
+
+        template<typename T>
+        inline static size_t estimateSize(const std::vector<T>& value) {
+            size_t size = sizeof(value);
+            for (const T& element : value) {
+                size += estimateSize(element);
+            }
+
+            return size;
+        }
+
+        template<typename T>
+        inline static size_t estimateSize(const T& value) {
+            return sizeof(value);
+        }
+    };
+} // namespace cas
@@ -0,0 +1,74 @@
+#pragma once
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+#include <mathlib/mathlib.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace cas::io {
+    // serves engine sessions over a unix domain socket. Every connection gets its own engine, the commands of all
+    // sessions are executed on a fixed pool of workers. The commands of one session are executed in order and the
+    // output of every command is sent back terminated by a null character.
+    class Server {
+      protected:
+        struct Session {
+            int socket;
+            Engine engine;
+
+            // received text after the last complete command
+            std::string buffer;
+
+            // guarded by the mutex of the server. A closing session receives no more commands and is closed after the
+            // pending commands are executed
+            std::deque<IOStream::Command> pending;
+            bool busy = false;
+            bool closing = false;
+        };
+
+        std::string path;
+        std::chrono::milliseconds timeout;
+        ResourceLimits limits;
+        size_t cacheCapacity;
+        int listenSocket = -1;
+        int wakeupPipe[2] = {-1, -1};
+
+        std::mutex mutex;
+        std::condition_variable sessionIdle;
+
+        // runs the commands with a timeout for all sessions, every worker waits for at most one command
+        cas::math::ThreadPool timeoutExecutor;
+        std::map<int, std::unique_ptr<Session>> sessions;
+
+        // closed sessions whose engine is poisoned are kept until the server stops
+        std::vector<std::unique_ptr<Session>> abandonedSessions;
+
+        cas::math::ThreadPool workers;
+
+        void acceptConnection();
+        void receive(Session& session);
+        void closeFinishedSessions();
+
+        // submits the pending commands of the session to the workers. The mutex has to be locked
+        void schedule(Session& session);
+        void processSession(Session& session);
+
+        static void send(int socket, const std::string& str);
+
+      public:
+        Server(const std::string& path, size_t workerCount, std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+               const ResourceLimits& limits = {}, size_t cacheCapacity = ResultCache::defaultCapacity);
+        Server(const Server& other) = delete;
+        ~Server();
+
+        // accepts connections until SIGINT or SIGTERM is received
+        void run();
+    };
+} // namespace cas::io
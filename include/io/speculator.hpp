@@ -0,0 +1,43 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <mathlib/mathlib.hpp>
+
+namespace cas {
+    class Engine;
+
+    // computes the results of the commands that usually follow an assignment on a background thread with low priority
+    // and stores them in the result cache of the engine: the simplified value and the derivatives with respect to all
+    // variables. A new assignment cancels the running computation, results of old values are never returned because the
+    // cache keys contain the values of the variables.
+    class Speculator {
+      protected:
+        Engine* engine;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<math::VariableSymbol> pending;
+        math::CancellationToken token;
+        bool stopping = false;
+        size_t completed = 0;
+
+        std::thread worker;
+
+        void workerLoop();
+        void precompute(const math::VariableSymbol& symbol);
+
+      public:
+        Speculator(Engine* engine);
+        Speculator(const Speculator& other) = delete;
+        ~Speculator();
+
+        // cancels the running computation and schedules the variable and its dependents
+        void schedule(const math::VariableSymbol& symbol);
+
+        // number of variables whose results were stored
+        size_t getCompleted();
+    };
+} // namespace cas
@@ -0,0 +1,94 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mathlib/mathlib.hpp>
+
+namespace cas {
+    // variables of an engine. A definition can reference other variables, the value of a variable is its definition
+    // with the referenced variables replaced by their values. Values are computed when they are needed and kept until a
+    // definition they depend on changes, so changing a definition only recomputes the variables downstream of it.
+    class VariableGraph {
+      protected:
+        // definitions and values are frozen, so they can be handed out without copying them while the graph is locked
+        struct Node {
+            math::FrozenExpression definition;
+            // empty if the value has to be recomputed
+            math::FrozenExpression value;
+            std::set<math::VariableSymbol> dependencies;
+        };
+
+        mutable std::mutex mutex;
+        std::map<math::VariableSymbol, Node> nodes;
+        // variables that reference a symbol, the symbol does not have to be defined
+        std::map<math::VariableSymbol, std::set<math::VariableSymbol>> dependents;
+        size_t recomputations = 0;
+
+        // graph of the active scope of the calling thread
+        static thread_local VariableGraph* current;
+
+        // true if one of the symbols depends on the target. Every symbol is visited at most once
+        bool reaches(const std::set<math::VariableSymbol>& from, const math::VariableSymbol& to) const;
+        void invalidate(const math::VariableSymbol& symbol);
+        void removeEdges(const math::VariableSymbol& symbol, const Node& node);
+
+        // replaces the definition after its dependencies were checked. The mutex has to be locked
+        void assign(const math::VariableSymbol& symbol, math::Expression* definition, std::set<math::VariableSymbol> dependencies);
+
+        static std::set<math::VariableSymbol> getDependencies(const math::Expression* definition);
+
+        const math::FrozenExpression& resolve(const math::VariableSymbol& symbol);
+        math::Expression* substituteResolved(const math::Expression* expr, const std::set<math::VariableSymbol>& excluded = {});
+
+        friend class VariableScope;
+
+      public:
+        VariableGraph() = default;
+        VariableGraph(const VariableGraph& other) = delete;
+
+        // takes the ownership of the definition. Throws if the definition references the variable itself
+        void define(const math::VariableSymbol& symbol, math::Expression* definition);
+
+        // takes the ownership of all definitions. Either all variables are defined or, if any definition would depend on
+        // its own variable, none of them
+        void defineAll(const std::vector<std::pair<math::VariableSymbol, math::Expression*>>& definitions);
+
+        bool contains(const math::VariableSymbol& symbol) const;
+        std::vector<math::VariableSymbol> getSymbols() const;
+
+        // copies of the definition and the value of a variable
+        math::Expression* getDefinition(const math::VariableSymbol& symbol) const;
+        math::Expression* getValue(const math::VariableSymbol& symbol);
+
+        // the shared value, it stays valid if the variable is changed later
+        math::FrozenExpression getSharedValue(const math::VariableSymbol& symbol);
+
+        // transitive dependents of the variable in topological order
+        std::vector<math::VariableSymbol> getDependents(const math::VariableSymbol& symbol) const;
+
+        // copy of the expression with all defined variables replaced by their values. The excluded variables are kept,
+        // e.g. the variables a command binds itself
+        math::Expression* substitute(const math::Expression* expr, const std::set<math::VariableSymbol>& excluded = {});
+        bool referencesVariables(const math::Expression* expr) const;
+
+        // number of values computed so far
+        size_t getRecomputations() const;
+
+        static VariableGraph* getCurrent();
+    };
+
+    // makes the variables visible to the commands executed by the calling thread
+    class VariableScope {
+      protected:
+        VariableGraph* previous;
+
+      public:
+        VariableScope(VariableGraph* graph);
+        VariableScope(const VariableScope& other) = delete;
+        ~VariableScope();
+    };
+} // namespace cas
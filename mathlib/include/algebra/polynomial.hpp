@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+namespace cas::math {
+    using Monomial = std::vector<unsigned int>;
+
+    struct polynomial_overflow_error : public std::overflow_error {
+        polynomial_overflow_error(const std::string& message);
+    };
+
+    // sparse multivariate polynomial with integer coefficients. The terms are ordered lexicographically
+    // with the first variable being the most significant one, so the first term is the leading term.
+    class Polynomial {
+      public:
+        using Terms = std::map<Monomial, int64_t, std::greater<Monomial>>;
+
+      protected:
+        size_t variableCount;
+        Terms terms;
+
+      public:
+        Polynomial(size_t variableCount = 0);
+
+        static Polynomial constant(size_t variableCount, int64_t value);
+        static Polynomial variable(size_t variableCount, size_t index);
+
+        size_t getVariableCount() const;
+        const Terms& getTerms() const;
+
+        bool isZero() const;
+        bool isConstant() const;
+
+        const Monomial& leadingMonomial() const;
+        int64_t leadingCoefficient() const;
+
+        unsigned int degree(size_t variable) const;
+
+        int64_t content() const;
+        Polynomial primitivePart() const;
+
+        void addTerm(const Monomial& monomial, int64_t coefficient);
+
+        Polynomial scale(int64_t factor) const;
+        Polynomial divideScalar(int64_t divisor) const;
+        Polynomial pow(unsigned int exponent) const;
+
+        bool divides(const Polynomial& dividend, Polynomial* quotient = nullptr) const;
+
+        Polynomial operator-() const;
+        Polynomial operator+(const Polynomial& other) const;
+        Polynomial operator-(const Polynomial& other) const;
+        Polynomial operator*(const Polynomial& other) const;
+
+        bool operator==(const Polynomial& other) const;
+    };
+
+    int64_t gcd(int64_t a, int64_t b);
+
+    Polynomial gcd(const Polynomial& a, const Polynomial& b);
+} // namespace cas::math
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "polynomial.hpp"
+
+#include "expressions/terms/expression.hpp"
+
+#include <string>
+#include <vector>
+
+namespace cas::math {
+    struct not_polynomial_error : public std::runtime_error {
+        not_polynomial_error(const std::string& message);
+    };
+
+    // quotient of two polynomials without common factors and with a positive leading coefficient in the denominator
+    class RationalFunction {
+      protected:
+        Polynomial numerator;
+        Polynomial denominator;
+
+        void cancel();
+
+      public:
+        RationalFunction(const Polynomial& numerator);
+        RationalFunction(const Polynomial& numerator, const Polynomial& denominator);
+
+        const Polynomial& getNumerator() const;
+        const Polynomial& getDenominator() const;
+
+        bool isPolynomial() const;
+
+        RationalFunction pow(int exponent) const;
+
+        RationalFunction operator+(const RationalFunction& other) const;
+        RationalFunction operator*(const RationalFunction& other) const;
+    };
+
+    // maps the kernels of an expression (variables and subexpressions that are not polynomial, e.g. sin(x)) to polynomial variables
+    class PolynomialMapping {
+      protected:
+        std::vector<std::string> keys;
+        std::vector<Expression*> kernels;
+
+        void addKernel(const Expression* expr);
+        size_t getKernelIndex(const Expression* expr) const;
+
+      public:
+        PolynomialMapping() = default;
+        PolynomialMapping(const PolynomialMapping& other) = delete;
+        ~PolynomialMapping();
+
+        void collect(const Expression* expr);
+
+        size_t getVariableCount() const;
+
+        Polynomial toPolynomial(const Expression* expr) const;
+        RationalFunction toRationalFunction(const Expression* expr) const;
+
+        Expression* toExpression(const Polynomial& poly) const;
+        Expression* toExpression(const RationalFunction& function) const;
+    };
+
+    Expression* cancel(const Expression* expr);
+
+    Expression* polynomialGcd(const Expression* a, const Expression* b);
+} // namespace cas::math
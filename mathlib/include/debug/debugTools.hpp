@@ -1,4 +1,6 @@
 #pragma once
 #include <fstream>
+#include <mutex>
 
-std::ofstream memLog = std::ofstream("memLog.log");
\ No newline at end of file
+std::ofstream memLog = std::ofstream("memLog.log");
+std::mutex memLogMutex;
\ No newline at end of file
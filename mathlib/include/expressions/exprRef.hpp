@@ -0,0 +1,52 @@
+#pragma once
+
+#include "frozenExpression.hpp"
+#include "terms/expression.hpp"
+
+#include <memory>
+
+namespace cas::math {
+    // reference counted handle of an expression tree. Copying the handle only increments the reference count, moving
+    // it transfers the reference. The tree is handed to a new parent with take(), which moves the tree out if the
+    // handle holds the last reference and only copies it if the tree is still used by other handles. Passing handles
+    // with std::move to add, multiply or power therefore builds expressions without copying subtrees.
+    //
+    // Like FrozenExpression the handle is backed by a shared_ptr, so it can share the tree of a frozen expression
+    // without copying it, e.g. the parsed arguments of commands.
+    class ExprRef {
+      protected:
+        // take() marks the tree as released before the last reference is dropped, so the tree is not deleted
+        struct Deleter {
+            bool released = false;
+
+            inline void operator()(const Expression* expr) const {
+                if (!released)
+                    delete expr;
+            }
+        };
+
+        std::shared_ptr<const Expression> expression;
+
+      public:
+        // empty handle
+        ExprRef() = default;
+
+        // takes the ownership of the expression. Subexpressions of other trees are copied
+        explicit ExprRef(Expression* expr);
+
+        // shares the tree of the frozen expression, take() always copies it
+        explicit ExprRef(const FrozenExpression& expr);
+
+        static ExprRef copyOf(const Expression* expr);
+
+        const Expression* get() const;
+        const Expression* operator->() const;
+        const Expression& operator*() const;
+        explicit operator bool() const;
+
+        long getUseCount() const;
+
+        // the tree for a new owner, the handle is empty afterwards. The tree is only copied if other handles use it
+        Expression* take();
+    };
+} // namespace cas::math
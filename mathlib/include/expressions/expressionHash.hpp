@@ -0,0 +1,16 @@
+#pragma once
+
+#include "terms/expression.hpp"
+
+#include <cstddef>
+
+namespace cas::math {
+    // hash of the tree structure. Expressions that are structurally equal have the same hash, the order of the
+    // operands is significant
+    size_t hashExpression(const Expression* expr);
+
+    // compares the types, values, symbols and children of both trees
+    bool equalExpressions(const Expression* lhs, const Expression* rhs);
+
+    size_t countNodes(const Expression* expr);
+} // namespace cas::math
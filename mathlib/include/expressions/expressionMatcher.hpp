@@ -10,25 +10,37 @@ namespace cas::math {
     struct ExpressionMatch {
         bool success;
         std::map<VariableSymbol, Expression*> variables;
+        // the matched node of the searched expression, or a copy of it after detach
         Expression* node;
+        bool ownsNode = false;
 
         ExpressionMatch(bool success, Expression* node, std::map<VariableSymbol, Expression*> variables = {});
         ExpressionMatch(const ExpressionMatch& other);
         ~ExpressionMatch();
 
         ExpressionMatch& operator=(const ExpressionMatch& other);
+
+        // replaces the node with a copy, so the match stays valid after the searched expression is deleted
+        void detach();
     };
 
     class ExpressionMatcher {
       protected:
         static ExpressionMatch combineMatches(const ExpressionMatch& first, const ExpressionMatch& second);
 
+        static std::vector<ExpressionMatch> matchAllSequential(Expression* expression, Expression* pattern);
+
       public:
         static bool matches(Expression* expr, Expression* pattern);
 
         static ExpressionMatch match(Expression* expression, Expression* pattern, bool recurse = false, std::map<VariableSymbol, Expression*> variables = {});
 
+        // subtrees with at least parallelThreshold nodes are searched in parallel. The matches are returned in
+        // preorder, the same order as a sequential search
         static std::vector<ExpressionMatch> matchAll(Expression* expression, Expression* pattern);
+        static std::vector<ExpressionMatch> matchAllParallel(Expression* expression, Expression* pattern, size_t threshold = parallelThreshold);
+
+        static constexpr size_t parallelThreshold = 4096;
 
         static Expression* substitute(Expression* expr, Expression* pattern, Expression* substitution);
     };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "exprRef.hpp"
 #include "functions.hpp"
 #include "terms/addition.hpp"
 #include "terms/number.hpp"
@@ -39,4 +40,9 @@ namespace cas {
     math::Expression* toExpression(T* expr) {
         return expr;
     }
+
+    // the tree is moved out of the handle if it holds the last reference
+    inline math::Expression* toExpression(math::ExprRef expr) {
+        return expr.take();
+    }
 } // namespace cas
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "terms/expression.hpp"
+#include "terms/variable.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace cas::math {
+    // immutable expression that can be read by many threads at once. The handle owns the tree and never changes it,
+    // operations that would change the expression return a new version. Copies of the handle share the tree, the
+    // reference count is atomic, so handles can be copied and released by different threads.
+    //
+    // The tree must not be passed to the constructors of other expressions, because they would take the ownership of
+    // the root. Use thaw() to get a copy that can be changed.
+    class FrozenExpression {
+      protected:
+        std::shared_ptr<const Expression> expression;
+
+        // computed once when the expression is frozen
+        size_t hash = 0;
+        size_t nodes = 0;
+
+        friend class ExprRef;
+
+      public:
+        // empty handle
+        FrozenExpression() = default;
+
+        // takes the ownership of the expression. Subexpressions of other trees are copied
+        explicit FrozenExpression(Expression* expr);
+
+        static FrozenExpression copyOf(const Expression* expr);
+
+        const Expression* get() const;
+        const Expression* operator->() const;
+        const Expression& operator*() const;
+        explicit operator bool() const;
+
+        size_t getHash() const;
+        size_t getNodeCount() const;
+        long getUseCount() const;
+
+        // a copy of the tree that belongs to the caller
+        Expression* thaw() const;
+
+        FrozenExpression simplify() const;
+        FrozenExpression differentiate(const Variable& var) const;
+        // the expression with every occurrence of the variable replaced by the value
+        FrozenExpression substitute(const Variable& var, const FrozenExpression& value) const;
+
+        // structural equality, the cached hashes are compared first
+        bool operator==(const FrozenExpression& other) const;
+    };
+} // namespace cas::math
+
+template<>
+struct std::hash<cas::math::FrozenExpression> {
+    inline size_t operator()(const cas::math::FrozenExpression& expr) const noexcept {
+        return expr.getHash();
+    }
+};
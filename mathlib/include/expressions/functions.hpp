@@ -3,3 +3,8 @@
 #include "functions/hyperbolic.hpp"
 #include "functions/logarithm.hpp"
 #include "functions/trigonometric.hpp"
+
+namespace cas::math {
+    // creates the function with the given name. Takes the ownership of the argument, throws if the function is unknown
+    BaseFunction* createFunction(const std::string& name, Expression* argument);
+} // namespace cas::math
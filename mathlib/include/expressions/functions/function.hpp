@@ -3,12 +3,20 @@
 #include "../terms/expression.hpp"
 #include "../terms/multiplication.hpp"
 #include "../terms/variable.hpp"
+#include "../../parallel/cancellation.hpp"
+#include "../resourceBudget.hpp"
 
+#include <memory>
 #include <sstream>
 
 namespace cas::math {
     struct BaseFunction : public Expression {
         const std::string name;
+
+        inline BaseFunction(const std::string& name)
+            : name(name) {
+        }
+
         virtual Expression* getDerivative() const = 0;
 
         inline virtual ExpressionTypes getType() const {
@@ -19,7 +27,18 @@ namespace cas::math {
     template<int u>
     struct Function : public BaseFunction {
       public:
-        Expression* arguments[u];
+        // the arguments are owned by the function
+        Expression* arguments[u] = {};
+
+        inline Function(const std::string& name)
+            : BaseFunction(name) {
+        }
+
+        inline virtual ~Function() {
+            for (Expression* argument : arguments) {
+                delete argument;
+            }
+        }
 
         inline virtual std::vector<Expression*> getChildren() const override {
             return std::vector<Expression*>(std::begin(arguments), std::end(arguments));
@@ -87,15 +106,17 @@ namespace cas::math {
         }
 
         inline virtual Expression* differentiate(const Variable* var) const override {
-            Expression* result = getDerivative();
+            checkCancellation();
+            DepthGuard depthGuard;
+
+            std::unique_ptr<Expression> result(getDerivative());
 
             for (int i = 0; i < u; i++) {
-                Expression* dArg = arguments[i]->differentiate(var);
-                Multiplication* prod = new Multiplication(result, dArg);
-                result = prod;
+                std::unique_ptr<Expression> dArg(arguments[i]->differentiate(var));
+                result.reset(makeNode<Multiplication>(result, dArg));
             }
 
-            return result;
+            return result.release();
         }
     };
 } // namespace cas::math
\ No newline at end of file
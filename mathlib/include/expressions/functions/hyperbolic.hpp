@@ -4,8 +4,6 @@
 
 namespace cas::math {
     struct Sinh : public Function<1> {
-        const std::string name = "sinh";
-
         Sinh(const Expression& argument);
         Sinh(Expression* argument);
 
@@ -18,8 +16,6 @@ namespace cas::math {
     };
 
     struct Asinh : public Function<1> {
-        const std::string name = "asinh";
-
         Asinh(const Expression& argument);
         Asinh(Expression* argument);
 
@@ -32,7 +28,6 @@ namespace cas::math {
     };
 
     struct Cosh : public Function<1> {
-        const std::string name = "cosh";
         Cosh(const Expression& argument);
         Cosh(Expression* argument);
 
@@ -45,8 +40,6 @@ namespace cas::math {
     };
 
     struct Acosh : public Function<1> {
-        const std::string name = "acosh";
-
         Acosh(const Expression& argument);
         Acosh(Expression* argument);
 
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "terms/expression.hpp"
+
+#include <vector>
+
+namespace cas::math {
+    // the operands of nested sums or products of the given type from left to right
+    std::vector<const Expression*> getOperands(const Expression* expr, ExpressionTypes type);
+
+    // simplifies every operand. Operands with at least parallelSimplifyThreshold nodes in total are split into chunks
+    // that are simplified on the thread pool, the results are in the same order as the operands
+    std::vector<Expression*> simplifyOperands(const std::vector<const Expression*>& operands);
+
+    // smaller operands are simplified inline, because submitting them to the thread pool takes longer than simplifying
+    // them
+    constexpr size_t parallelSimplifyThreshold = 1024;
+
+    // real constant that is no named constant, like pi, or complex number
+    bool isRealNumber(const Expression* expr);
+} // namespace cas::math
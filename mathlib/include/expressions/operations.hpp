@@ -1,34 +1,87 @@
 #pragma once
 #include "expressions.hpp"
 
+#include <memory>
+#include <utility>
+
 namespace cas::math {
+    namespace detail {
+        // holds an operand until the node is created. Expressions passed as pointers are owned at once and the other
+        // operands are only converted when the node is built, so a failed allocation does not leak an operand
+        template<typename T>
+        struct Operand {
+            T value;
+
+            inline explicit Operand(T value)
+                : value(std::move(value)) {
+            }
+
+            inline std::unique_ptr<Expression> take() {
+                return std::unique_ptr<Expression>(toExpression(std::move(value)));
+            }
+        };
+
+        template<ExpressionType T>
+        struct Operand<T*> {
+            std::unique_ptr<Expression> value;
+
+            inline explicit Operand(T* value)
+                : value(value) {
+            }
+
+            inline std::unique_ptr<Expression> take() {
+                return std::move(value);
+            }
+        };
+
+        template<typename TNode, typename TLeft, typename TRight>
+        inline Expression* combine(TLeft left, TRight right) {
+            Operand<TLeft> leftOperand(std::move(left));
+            Operand<TRight> rightOperand(std::move(right));
+
+            std::unique_ptr<Expression> leftExpr = leftOperand.take();
+            std::unique_ptr<Expression> rightExpr = rightOperand.take();
+            return makeNode<TNode>(leftExpr, rightExpr);
+        }
+    } // namespace detail
+
+    // the operands can be numbers, symbols, expressions or ExprRef handles. Handles passed with std::move give their
+    // tree to the new expression without copying it
     template<typename TLeft, typename TRight>
     inline Expression* add(TLeft left, TRight right) {
-        return new Addition(toExpression(left), toExpression(right));
+        return detail::combine<Addition>(std::move(left), std::move(right));
     }
 
     template<typename TLeft, typename TRight>
     inline Expression* multiply(TLeft left, TRight right) {
-        return new Multiplication(toExpression(left), toExpression(right));
+        return detail::combine<Multiplication>(std::move(left), std::move(right));
     }
 
     template<typename TLeft, typename TRight>
     Expression* power(TLeft left, TRight right) {
-        return new Exponentiation(toExpression(left), toExpression(right));
+        return detail::combine<Exponentiation>(std::move(left), std::move(right));
     }
 
     template<typename TLeft, typename TRight>
     inline Expression* subtract(TLeft left, TRight right) {
-        return add(left, multiply(-1, right));
+        detail::Operand<TLeft> leftOperand(std::move(left));
+        std::unique_ptr<Expression> negated(multiply(-1, std::move(right)));
+
+        std::unique_ptr<Expression> leftExpr = leftOperand.take();
+        return makeNode<Addition>(leftExpr, negated);
     }
 
     template<typename TLeft, typename TRight>
     Expression* divide(TLeft left, TRight right) {
-        return multiply(left, power(right, -1));
+        detail::Operand<TLeft> leftOperand(std::move(left));
+        std::unique_ptr<Expression> inverse(power(std::move(right), -1));
+
+        std::unique_ptr<Expression> leftExpr = leftOperand.take();
+        return makeNode<Multiplication>(leftExpr, inverse);
     }
 
     template<typename T>
     Expression* sqrt(T expression) {
-        return power(expression, 0.5);
+        return power(std::move(expression), 0.5);
     }
 } // namespace cas::math
\ No newline at end of file
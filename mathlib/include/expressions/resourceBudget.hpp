@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace cas::math {
+    struct resource_limit_error : public std::runtime_error {
+        resource_limit_error(const std::string& message);
+    };
+
+    // a limit of zero means unlimited
+    struct ResourceLimits {
+        size_t maxNodes = 0;
+        size_t maxBytes = 0;
+        size_t maxDepth = 0;
+    };
+
+    // counts the expression nodes that are allocated while the budget is active. Nodes deleted while the budget is
+    // active are subtracted if they were allocated under the same budget, so the counters contain the nodes that were
+    // created and are still alive. The budget can be shared by several threads working on the same command.
+    class ResourceBudget {
+      protected:
+        ResourceLimits limits;
+
+        // every node stores the id of the budget it was charged to. The budget itself can be destroyed before its nodes
+        static std::atomic<size_t> nextId;
+        const size_t id;
+
+        std::atomic<long long> nodes = 0;
+        std::atomic<long long> bytes = 0;
+
+        // budget of the active scope of the calling thread
+        static thread_local ResourceBudget* current;
+        static thread_local size_t depth;
+
+        friend class BudgetScope;
+        friend class DepthGuard;
+
+      public:
+        ResourceBudget(const ResourceLimits& limits);
+        ResourceBudget(const ResourceBudget& other) = delete;
+
+        const ResourceLimits& getLimits() const;
+        long long getNodes() const;
+        long long getBytes() const;
+
+        // called by the allocation of every expression node. Returns the id of the charged budget or zero if no budget
+        // is active
+        static size_t allocate(size_t size);
+        // credits the active budget if it is the one with the given id
+        static void release(size_t size, size_t owner);
+
+        static ResourceBudget* getCurrent();
+    };
+
+    // activates the budget for the calling thread until the scope ends
+    class BudgetScope {
+      protected:
+        ResourceBudget* previous;
+        size_t previousDepth;
+
+      public:
+        BudgetScope(ResourceBudget* budget);
+        BudgetScope(const BudgetScope& other) = delete;
+        ~BudgetScope();
+    };
+
+    // counts the recursion depth of the calling thread and throws if it exceeds the limit of the active budget
+    class DepthGuard {
+      public:
+        DepthGuard();
+        DepthGuard(const DepthGuard& other) = delete;
+        ~DepthGuard();
+    };
+} // namespace cas::math
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -29,11 +32,15 @@ namespace cas::math {
         Expression* parent = nullptr;
 
 #if DEBUG
-        static unsigned int expressionCounter;
+        static std::atomic<unsigned int> expressionCounter;
         Expression();
 #endif
         virtual ~Expression();
 
+        // every node is counted by the resource budget of the calling thread
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr, std::size_t size);
+
         virtual Number getValue() const = 0;
         virtual Expression* copy() const = 0;
         virtual ExpressionTypes getType() const = 0;
@@ -57,6 +64,14 @@ namespace cas::math {
     };
 
     Expression* assign(Expression* other, Expression* parent);
+
+    // creates a node from operands without a parent. The node is allocated before the operands are released, so the
+    // operands are deleted if the allocation fails, e.g. because the resource budget is exhausted
+    template<typename T, typename... TOperands>
+    inline T* makeNode(std::unique_ptr<TOperands>&... operands) {
+        return new T(operands.release()...);
+    }
+
     std::ostream& operator<<(std::ostream& os, const Expression& expr);
     std::ostream& operator<<(std::ostream& os, Expression* expr);
 } // namespace cas::math
\ No newline at end of file
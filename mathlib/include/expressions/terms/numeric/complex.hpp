@@ -13,7 +13,7 @@ namespace cas::math {
         virtual Number getValue() const override;
         virtual Expression* copy() const override;
 
-        virtual Number conjugate() const;
+        virtual Complex conjugate() const;
         virtual double abs() const;
         virtual double arg() const;
 
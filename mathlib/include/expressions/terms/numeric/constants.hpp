@@ -34,6 +34,13 @@ namespace cas::math {
         }
     };
 
+    struct Pi : public NamedConstant {
+      public:
+        inline Pi()
+            : NamedConstant("pi", std::numbers::pi) {
+        }
+    };
+
     struct I : public NamedConstant {
         inline I()
             : NamedConstant("i", Complex(0, 1)) {
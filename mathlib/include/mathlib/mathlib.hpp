@@ -2,4 +2,20 @@
 #include "expressions/expressions.hpp"
 #include "expressions/expressionMatcher.hpp"
 #include "operators/differential.hpp"
-#include "expressions/simplifier.hpp"
\ No newline at end of file
+#include "expressions/simplifier.hpp"
+#include "algebra/rationalFunction.hpp"
+#include "numeric/polynomialRoots.hpp"
+#include "numeric/newton.hpp"
+#include "numeric/integration.hpp"
+#include "operators/series.hpp"
+#include "parallel/threadPool.hpp"
+#include "parallel/cancellation.hpp"
+#include "expressions/resourceBudget.hpp"
+#include "expressions/expressionHash.hpp"
+#include "serialization/snapshot.hpp"
+#include "serialization/binaryEncoding.hpp"
+#include "parallel/ringBuffer.hpp"
+#include "parallel/taskGroup.hpp"
+#include "numeric/sweep.hpp"
+#include "expressions/frozenExpression.hpp"
+#include "expressions/exprRef.hpp"
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "expressions/terms/expression.hpp"
+#include "expressions/terms/variable.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace cas::math {
+    // expression translated into a flat postfix program that evaluates without walking the tree. Subexpressions
+    // without variables are folded into constants.
+    class CompiledExpression {
+      public:
+        enum class OpCode : uint8_t {
+            Constant,
+            Variable,
+            Add,
+            Multiply,
+            Power,
+            IntegerPower,
+            Sin,
+            Arcsin,
+            Cos,
+            Arccos,
+            Tan,
+            Arctan,
+            Sinh,
+            Asinh,
+            Cosh,
+            Acosh,
+            Ln
+        };
+
+        struct Instruction {
+            OpCode opCode;
+            int index = 0;
+            double value = 0;
+        };
+
+      protected:
+        std::vector<Instruction> instructions;
+        size_t stackSize = 0;
+        size_t variableCount = 0;
+        size_t variableReferences = 0;
+
+        size_t compile(const Expression* expr, const std::vector<Variable>& variables);
+
+      public:
+        CompiledExpression(const Expression* expr, const std::vector<Variable>& variables);
+
+        const std::vector<Instruction>& getInstructions() const;
+
+        // values contains the values of the variables in the order they were passed to the constructor
+        double evaluate(const double* values) const;
+
+        // evaluates count points at once. The values of point i start at values[i * variableCount], the instructions
+        // are executed for blocks of points so the dispatch cost is shared.
+        void evaluate(const double* values, size_t count, double* results) const;
+    };
+} // namespace cas::math
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "compiledExpression.hpp"
+
+namespace cas::math {
+    struct IntegrationOptions {
+        double absoluteTolerance = 1e-10;
+        double relativeTolerance = 1e-10;
+        size_t maxIntervals = 4096;
+    };
+
+    struct IntegrationResult {
+        double value;
+        double error;
+        size_t evaluations;
+        size_t intervals;
+        bool converged;
+    };
+
+    // adaptive Gauss-Kronrod (G7, K15) quadrature. The intervals with the largest error estimates are bisected in rounds
+    // and the halves of one round are evaluated on the thread pool.
+    IntegrationResult integrate(const CompiledExpression& integrand, double a, double b, const IntegrationOptions& options = {});
+
+    IntegrationResult integrate(const Expression* expr, const Variable& var, double a, double b, const IntegrationOptions& options = {});
+} // namespace cas::math
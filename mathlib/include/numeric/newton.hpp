@@ -0,0 +1,47 @@
+#pragma once
+
+#include "compiledExpression.hpp"
+
+#include <map>
+
+namespace cas::math {
+    struct NewtonOptions {
+        double tolerance = 1e-12;
+        int maxIterations = 100;
+        double minDamping = 1.0 / 1024;
+    };
+
+    struct NewtonSolution {
+        // true if the residual is below the tolerance
+        bool converged;
+        // true if the steps became smaller than the tolerance before the residual did
+        bool stalled;
+        int iterations;
+        double residual;
+        std::map<VariableSymbol, double> values;
+    };
+
+    // system of equations f_i(x) = 0. The jacobian is differentiated symbolically once and both the residuals and the
+    // jacobian are compiled, so every newton step only runs the compiled programs.
+    class NonlinearSystem {
+      protected:
+        std::vector<Variable> variables;
+        std::vector<CompiledExpression> residuals;
+        std::vector<CompiledExpression> jacobian;
+
+        void evaluateResiduals(const std::vector<double>& x, std::vector<double>& result) const;
+        void evaluateJacobian(const std::vector<double>& x, std::vector<double>& result) const;
+
+      public:
+        NonlinearSystem(const std::vector<Expression*>& equations, const std::vector<Variable>& variables);
+
+        const std::vector<Variable>& getVariables() const;
+
+        NewtonSolution solve(const std::vector<double>& start, const NewtonOptions& options = {}) const;
+
+        // the starting points are solved independently on the thread pool
+        std::vector<NewtonSolution> solve(const std::vector<std::vector<double>>& starts, const NewtonOptions& options = {}) const;
+    };
+
+    std::vector<NewtonSolution> nsolve(const std::vector<Expression*>& equations, const std::vector<Variable>& variables, const std::vector<std::vector<double>>& starts);
+} // namespace cas::math
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "expressions/terms/expression.hpp"
+#include "expressions/terms/numeric/complex.hpp"
+#include "expressions/terms/variable.hpp"
+
+#include <vector>
+
+namespace cas::math {
+    // returns the coefficients of the polynomial in ascending order. Polynomials of a degree above 4096 are rejected
+    std::vector<double> getCoefficients(const Expression* expr, const Variable& var);
+
+    struct PolynomialRoot {
+        Complex value;
+        // false if the iteration limit was reached before the root was found with the required tolerance, or if the iteration
+        // stalled at a multiple root that can not be resolved with the required tolerance
+        bool converged;
+    };
+
+    // the roots are sorted by their real and imaginary part
+    std::vector<PolynomialRoot> findRoots(std::vector<double> coefficients, double tolerance = 1e-14, int maxIterations = 1000);
+
+    std::vector<PolynomialRoot> roots(const Expression* expr, const Variable& var);
+} // namespace cas::math
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "compiledExpression.hpp"
+
+#include <ostream>
+#include <string>
+
+namespace cas::math {
+    // count equidistant values from begin to end, both included
+    struct SweepAxis {
+        Variable variable;
+        double begin;
+        double end;
+        size_t count;
+
+        double getValue(size_t index) const;
+    };
+
+    enum class SweepFormat {
+        Csv,
+        Binary
+    };
+
+    // evaluates the expression at every point of the grid spanned by the axes, the last axis changes fastest. The points
+    // are evaluated in blocks on the thread pool and written in order, so only a few blocks are kept in memory.
+    // The CSV output starts with a header of the variables, the binary output contains the coordinates and the value of
+    // every point as little-endian doubles. Returns the number of points.
+    size_t sweep(const Expression* expr, const std::vector<SweepAxis>& axes, std::ostream& stream, SweepFormat format);
+    // writes the sweep into a file. The axes are checked and the expression is compiled before the file is touched, and
+    // an existing file is only replaced after all points were written
+    size_t sweep(const Expression* expr, const std::vector<SweepAxis>& axes, const std::string& path, SweepFormat format);
+} // namespace cas::math
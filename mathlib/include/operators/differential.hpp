@@ -2,11 +2,23 @@
 #include "../expressions/expressions.hpp"
 
 #include <stdexcept>
+#include <vector>
 
 namespace cas::math {
-    Expression* D(Expression* expr);
+    Expression* D(const Expression* expr);
 
-    Expression* D(Expression* expr, const Variable& var);
+    Expression* D(const Expression* expr, const Variable& var);
 
     Expression* DFunction(BaseFunction* function, const Variable& var);
+
+    // the derivatives with respect to the different variables are calculated in parallel, expr is only read
+    std::vector<Expression*> partialDerivatives(const Expression* expr, const std::vector<Variable>& variables, bool simplify = false);
+
+    // like partialDerivatives, but with Expression::differentiate instead of D, which gives the derivatives in the form
+    // printed by the D command
+    std::vector<Expression*> differentiateAll(const Expression* expr, const std::vector<Variable>& variables);
+
+    // the derivatives of all expressions in row-major order, entry i * variables.size() + j is the derivative of
+    // expressions[i] with respect to variables[j]. All entries are calculated in parallel
+    std::vector<Expression*> jacobian(const std::vector<Expression*>& expressions, const std::vector<Variable>& variables, bool simplify = false);
 } // namespace cas::math
\ No newline at end of file
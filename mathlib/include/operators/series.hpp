@@ -0,0 +1,48 @@
+#pragma once
+#include "../expressions/expressions.hpp"
+
+#include <vector>
+
+namespace cas::math {
+    // power series c_0 + c_1 (x - x0) + ... + c_n (x - x0)^n truncated after the order n. All operations are done on the
+    // coefficients with the usual recurrences, so every operation costs at most O(n^2).
+    class PowerSeries {
+      protected:
+        std::vector<double> coefficients;
+
+      public:
+        PowerSeries(size_t order, double constant = 0);
+
+        static PowerSeries variable(size_t order, double x0);
+
+        size_t getOrder() const;
+        const std::vector<double>& getCoefficients() const;
+
+        double operator[](size_t k) const;
+        double& operator[](size_t k);
+
+        PowerSeries derivative() const;
+        PowerSeries integral(double constant) const;
+
+        PowerSeries operator+(const PowerSeries& other) const;
+        PowerSeries operator-(const PowerSeries& other) const;
+        PowerSeries operator*(const PowerSeries& other) const;
+        PowerSeries operator/(const PowerSeries& other) const;
+        PowerSeries operator*(double factor) const;
+
+        PowerSeries pow(int exponent) const;
+        PowerSeries pow(double exponent) const;
+
+        PowerSeries exp() const;
+        PowerSeries ln() const;
+
+        // calculates the series of sin and cos at once
+        void sinCos(PowerSeries& sin, PowerSeries& cos) const;
+        void sinhCosh(PowerSeries& sinh, PowerSeries& cosh) const;
+    };
+
+    // power series of expr in var around x0 up to the order n
+    PowerSeries taylorSeries(const Expression* expr, const Variable& var, double x0, size_t order);
+
+    Expression* series(const Expression* expr, const Variable& var, double x0, size_t order);
+} // namespace cas::math
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+namespace cas::math {
+    struct operation_cancelled_error : public std::runtime_error {
+        operation_cancelled_error();
+    };
+
+    // shared flag to request the cancellation of a running operation. Copies of a token refer to the same flag
+    class CancellationToken {
+      protected:
+        std::shared_ptr<std::atomic<bool>> cancelled;
+
+        // flag of the active scope of the calling thread
+        static thread_local std::shared_ptr<std::atomic<bool>> currentFlag;
+
+        CancellationToken(const std::shared_ptr<std::atomic<bool>>& cancelled);
+
+        friend class CancellationScope;
+        friend void checkCancellation();
+
+      public:
+        CancellationToken();
+
+        void cancel() const;
+        bool isCancelled() const;
+
+        // token of the calling thread, or a token without a flag if no scope is active
+        static CancellationToken current();
+    };
+
+    // installs the token for the calling thread until the scope ends
+    class CancellationScope {
+      protected:
+        std::shared_ptr<std::atomic<bool>> previous;
+
+      public:
+        CancellationScope(const CancellationToken& token);
+        CancellationScope(const CancellationScope& other) = delete;
+        ~CancellationScope();
+    };
+
+    // cooperative cancellation point of long running routines. Throws operation_cancelled_error if the token of the
+    // calling thread was cancelled
+    void checkCancellation();
+} // namespace cas::math
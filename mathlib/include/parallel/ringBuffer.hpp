@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+
+namespace cas::math {
+    // bounded lock-free queue for several producers and one consumer. A full queue rejects new elements instead of
+    // blocking the producer.
+    template<typename T>
+    class RingBuffer {
+      protected:
+        struct Slot {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        const size_t mask;
+        std::unique_ptr<Slot[]> slots;
+
+        alignas(64) std::atomic<size_t> enqueuePosition = 0;
+        alignas(64) size_t dequeuePosition = 0;
+
+      public:
+        // the capacity is rounded up to a power of two
+        inline RingBuffer(size_t capacity)
+            : mask(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), slots(new Slot[mask + 1]) {
+            for (size_t i = 0; i <= mask; i++) {
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        RingBuffer(const RingBuffer& other) = delete;
+
+        // can be called from any thread. Returns false if the queue is full
+        inline bool push(T&& value) {
+            size_t position = enqueuePosition.load(std::memory_order_relaxed);
+            Slot* slot;
+
+            while (true) {
+                slot = &slots[position & mask];
+                const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (difference == 0) {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (difference < 0) {
+                    return false;
+                }
+                else {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            slot->value = std::move(value);
+            slot->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // must only be called by the consumer. Returns false if the queue is empty
+        inline bool pop(T& value) {
+            Slot& slot = slots[dequeuePosition & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+                return false;
+
+            value = std::move(slot.value);
+            slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+            dequeuePosition++;
+            return true;
+        }
+
+        inline size_t getCapacity() const {
+            return mask + 1;
+        }
+    };
+} // namespace cas::math
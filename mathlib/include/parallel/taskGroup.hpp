@@ -0,0 +1,47 @@
+#pragma once
+
+#include "cancellation.hpp"
+#include "threadPool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace cas::math {
+    class ResourceBudget;
+
+    // set of tasks on a thread pool that can be waited for. Tasks can add further tasks to their group. The waiting
+    // thread runs pending tasks of the pool, so groups can be used from inside tasks of the same pool.
+    class TaskGroup {
+      protected:
+        struct State {
+            std::atomic<size_t> pending = 0;
+            std::atomic<bool> failed = false;
+
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr exception;
+        };
+
+        ThreadPool& pool;
+        std::shared_ptr<State> state;
+
+        // the tasks are cancelled together with the creating thread and count their nodes in its budget
+        CancellationToken token;
+        ResourceBudget* budget;
+
+      public:
+        TaskGroup(ThreadPool& pool = ThreadPool::shared());
+        TaskGroup(const TaskGroup& other) = delete;
+        ~TaskGroup();
+
+        // tasks added after a task of the group failed are skipped
+        void run(std::function<void()> task);
+
+        // waits until all tasks finished and rethrows the first exception of a task
+        void wait();
+    };
+} // namespace cas::math
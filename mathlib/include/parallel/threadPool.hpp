@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cas::math {
+    // pool of worker threads with a task queue per worker. Tasks submitted by a worker are pushed to its own queue and
+    // taken from the back, so nested tasks run depth first. Idle workers steal from the front of the other queues.
+    // Tasks submitted by other threads are distributed over a shared queue.
+    class ThreadPool {
+      protected:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::thread> workers;
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::atomic<size_t> pendingTasks = 0;
+        bool stopping = false;
+
+        // pool and queue index of the calling thread if it is a worker
+        static thread_local ThreadPool* currentPool;
+        static thread_local size_t currentWorker;
+
+        void workerLoop(size_t index);
+
+        void enqueue(std::function<void()> task);
+        bool takeTask(std::function<void()>& task);
+
+      public:
+        ThreadPool(size_t threadCount = std::thread::hardware_concurrency());
+        ThreadPool(const ThreadPool& other) = delete;
+        ~ThreadPool();
+
+        size_t getThreadCount() const;
+
+        // runs one pending task on the calling thread. Used to help the workers while waiting for tasks. Returns false
+        // if no task was pending
+        bool runPendingTask();
+
+        template<typename TFunc>
+        inline auto submit(TFunc&& func) -> std::future<std::invoke_result_t<TFunc>> {
+            using TRes = std::invoke_result_t<TFunc>;
+
+            auto task = std::make_shared<std::packaged_task<TRes()>>(std::forward<TFunc>(func));
+            std::future<TRes> result = task->get_future();
+
+            enqueue([task]() { (*task)(); });
+            return result;
+        }
+
+        // calls body(chunkBegin, chunkEnd) for chunks of [begin, end). The calling thread works on the chunks too,
+        // so parallelFor can be used from inside a task of the pool.
+        void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grainSize = 1);
+
+        static ThreadPool& shared();
+    };
+} // namespace cas::math
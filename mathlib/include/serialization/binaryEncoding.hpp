@@ -0,0 +1,66 @@
+#pragma once
+
+#include "nodeTag.hpp"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cas::math {
+    // binary encoding of a sequence of expressions:
+    //   magic "CASE", format version (varint)
+    //   expressions in preorder, every node starts with its tag:
+    //     addition, multiplication, exponentiation, function: child count (varint), function name, children
+    //     number: real part, complex: real and imaginary part as little endian doubles
+    //     named constant: symbol, real part
+    //     variable, differential: symbol
+    // A symbol is written as its index in the symbol table plus one. The first occurrence of a symbol is written as 0
+    // followed by its length (varint) and its characters, the symbol is then appended to the table. The table is shared
+    // by all expressions of the stream.
+    class ExpressionWriter {
+      protected:
+        std::ostream& stream;
+        std::unordered_map<std::string, uint64_t> symbols;
+
+        void writeVarint(uint64_t value);
+        void writeDouble(double value);
+        void writeSymbol(const std::string& symbol);
+        void writeNode(const Expression* expr);
+
+      public:
+        static constexpr uint64_t version = 1;
+
+        // writes the header
+        ExpressionWriter(std::ostream& stream);
+
+        void write(const Expression* expr);
+    };
+
+    // reads the expressions from a buffer without copying it. The buffer has to outlive the reader
+    class ExpressionReader {
+      protected:
+        const uint8_t* position;
+        const uint8_t* end;
+        std::vector<std::string_view> symbols;
+
+        uint64_t readVarint();
+        double readDouble();
+        std::string_view readSymbol();
+        Expression* readNode();
+
+      public:
+        // reads the header
+        ExpressionReader(const void* data, size_t size);
+        ExpressionReader(std::string_view data);
+
+        bool atEnd() const;
+
+        Expression* read();
+    };
+
+    std::string encodeExpression(const Expression* expr);
+    Expression* decodeExpression(std::string_view data);
+} // namespace cas::math
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "expressions/terms/expression.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace cas::math {
+    struct serialization_error : public std::runtime_error {
+        serialization_error(const std::string& message);
+    };
+
+    // type of a serialized node. The values are part of the file formats and must not change
+    enum class NodeTag : uint8_t {
+        Addition = 0,
+        Multiplication = 1,
+        Exponentiation = 2,
+        Function = 3,
+        Number = 4,
+        Complex = 5,
+        NamedConstant = 6,
+        Variable = 7,
+        Differential = 8
+    };
+
+    NodeTag getNodeTag(const Expression* expr);
+
+    // number of children of the nodes with the given tag
+    size_t getChildCount(NodeTag tag);
+
+    // the symbol of a function, named constant, variable or differential, otherwise empty
+    std::string getNodeSymbol(const Expression* expr);
+
+    // creates a node from its serialized fields and takes the ownership of the children. Unused fields are ignored
+    Expression* createNode(NodeTag tag, const std::string& symbol, double real, double imaginary, Expression* left = nullptr,
+                           Expression* right = nullptr);
+} // namespace cas::math
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "nodeTag.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cas::math {
+    // file layout of a snapshot:
+    //   header
+    //   nodes[nodeCount]       children are stored before their parents and referenced by index
+    //   roots[rootCount]       named expressions
+    //   offsets[symbolCount + 1] begin of every symbol in the symbol data
+    //   symbol data
+    // All values are stored in the byte order of the machine that wrote the snapshot.
+    struct SnapshotHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t nodeCount;
+        uint32_t rootCount;
+        uint32_t symbolCount;
+        uint32_t reserved;
+        uint64_t symbolBytes;
+    };
+
+    struct SnapshotNode {
+        NodeTag tag;
+        uint8_t reserved[3];
+        // index into the symbol table for functions, named constants, variables and differentials
+        uint32_t symbol;
+        uint32_t children[2];
+        double real;
+        double imaginary;
+    };
+
+    struct SnapshotRoot {
+        uint32_t name;
+        uint32_t node;
+    };
+
+    // collects named expressions and writes them as a snapshot. Equal subtrees are stored only once.
+    class SnapshotWriter {
+      protected:
+        struct NodeHash {
+            size_t operator()(const SnapshotNode& node) const;
+        };
+
+        struct NodeEqual {
+            bool operator()(const SnapshotNode& lhs, const SnapshotNode& rhs) const;
+        };
+
+        std::vector<SnapshotNode> nodes;
+        std::unordered_map<SnapshotNode, uint32_t, NodeHash, NodeEqual> nodeIndices;
+
+        std::vector<std::string> symbols;
+        std::unordered_map<std::string, uint32_t> symbolIndices;
+
+        std::vector<SnapshotRoot> roots;
+
+        uint32_t addNode(const Expression* expr);
+        uint32_t addSymbol(const std::string& symbol);
+
+      public:
+        static constexpr uint32_t version = 1;
+
+        void add(const std::string& name, const Expression* expr);
+
+        // the snapshot is written to a temporary file first, so an existing file is only replaced by a complete snapshot
+        void write(const std::string& path) const;
+    };
+
+    // snapshot mapped into memory. The expressions are created directly from the node table.
+    class Snapshot {
+      protected:
+        const char* data = nullptr;
+        size_t size = 0;
+        // fallback if the file can not be mapped
+        std::vector<char> buffer;
+
+        const SnapshotHeader* header;
+        const SnapshotNode* nodes;
+        const SnapshotRoot* roots;
+        const uint32_t* symbolOffsets;
+        const char* symbolData;
+
+        void validate();
+        std::string_view getSymbol(uint32_t index) const;
+        Expression* createExpression(uint32_t node) const;
+
+      public:
+        Snapshot(const std::string& path);
+        Snapshot(const Snapshot& other) = delete;
+        ~Snapshot();
+
+        size_t getRootCount() const;
+        std::string_view getName(size_t root) const;
+
+        // creates a new expression from the node table
+        Expression* load(size_t root) const;
+    };
+} // namespace cas::math
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "algebra/polynomial.hpp"
+
+#include <cstdint>
+#include <limits>
+
+namespace cas::math {
+    inline int64_t checkedAdd(int64_t a, int64_t b) {
+#if defined(_MSC_VER)
+        if ((b > 0 && a > std::numeric_limits<int64_t>::max() - b) || (b < 0 && a < std::numeric_limits<int64_t>::min() - b))
+            throw polynomial_overflow_error("Integer overflow in polynomial arithmetic");
+
+        return a + b;
+#else
+        int64_t result;
+        if (__builtin_add_overflow(a, b, &result))
+            throw polynomial_overflow_error("Integer overflow in polynomial arithmetic");
+
+        return result;
+#endif
+    }
+
+    inline int64_t checkedMultiply(int64_t a, int64_t b) {
+#if defined(_MSC_VER)
+        constexpr int64_t max = std::numeric_limits<int64_t>::max();
+        constexpr int64_t min = std::numeric_limits<int64_t>::min();
+
+        bool overflow = a > 0 ? (b > 0 ? a > max / b : b < min / a)
+                              : (b > 0 ? a < min / b : (a != 0 && b < max / a));
+        if (overflow)
+            throw polynomial_overflow_error("Integer overflow in polynomial arithmetic");
+
+        return a * b;
+#else
+        int64_t result;
+        if (__builtin_mul_overflow(a, b, &result))
+            throw polynomial_overflow_error("Integer overflow in polynomial arithmetic");
+
+        return result;
+#endif
+    }
+} // namespace cas::math
@@ -0,0 +1,583 @@
+#include "algebra/polynomial.hpp"
+
+#include "checkedArithmetic.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <algorithm>
+
+// Brown's dense modular gcd algorithm: the gcd is computed modulo several word size primes. In Z_p the variables are
+// eliminated one after another by evaluation and recovered by Newton interpolation. The images are combined with the
+// chinese remainder theorem until the result divides both inputs.
+
+namespace cas::math {
+    namespace {
+        using ModularTerms = std::map<Monomial, uint64_t, std::greater<Monomial>>;
+        using UnivariatePolynomial = std::vector<uint64_t>;
+
+        inline uint64_t addMod(uint64_t a, uint64_t b, uint64_t p) {
+            uint64_t result = a + b;
+            return result >= p ? result - p : result;
+        }
+
+        inline uint64_t subtractMod(uint64_t a, uint64_t b, uint64_t p) {
+            return a >= b ? a - b : a + p - b;
+        }
+
+        inline uint64_t multiplyMod(uint64_t a, uint64_t b, uint64_t p) {
+            // the primes are smaller than 2^31, so the product fits into 64 bits
+            return (a * b) % p;
+        }
+
+        uint64_t powMod(uint64_t base, uint64_t exponent, uint64_t p) {
+            uint64_t result = 1;
+            base %= p;
+
+            while (exponent > 0) {
+                if (exponent & 1)
+                    result = multiplyMod(result, base, p);
+
+                base = multiplyMod(base, base, p);
+                exponent >>= 1;
+            }
+
+            return result;
+        }
+
+        inline uint64_t inverseMod(uint64_t a, uint64_t p) {
+            return powMod(a, p - 2, p);
+        }
+
+        inline uint64_t reduce(int64_t value, uint64_t p) {
+            int64_t result = value % static_cast<int64_t>(p);
+            return static_cast<uint64_t>(result < 0 ? result + static_cast<int64_t>(p) : result);
+        }
+
+        inline int64_t symmetric(uint64_t value, uint64_t p) {
+            return value > p / 2 ? static_cast<int64_t>(value) - static_cast<int64_t>(p) : static_cast<int64_t>(value);
+        }
+
+        std::vector<uint64_t> getPrimes() {
+            std::vector<uint64_t> primes;
+            uint64_t candidate = (uint64_t(1) << 31) - 1;
+
+            while (primes.size() < 32) {
+                bool prime = true;
+                for (uint64_t divisor = 3; divisor * divisor <= candidate; divisor += 2) {
+                    if (candidate % divisor == 0) {
+                        prime = false;
+                        break;
+                    }
+                }
+
+                if (prime)
+                    primes.push_back(candidate);
+
+                candidate -= 2;
+            }
+
+            return primes;
+        }
+
+#pragma region Univariate
+        void trim(UnivariatePolynomial& poly) {
+            while (!poly.empty() && poly.back() == 0) {
+                poly.pop_back();
+            }
+        }
+
+        uint64_t evaluate(const UnivariatePolynomial& poly, uint64_t x, uint64_t p) {
+            uint64_t result = 0;
+            for (auto it = poly.rbegin(); it != poly.rend(); it++) {
+                result = addMod(multiplyMod(result, x, p), *it, p);
+            }
+
+            return result;
+        }
+
+        UnivariatePolynomial multiply(const UnivariatePolynomial& a, const UnivariatePolynomial& b, uint64_t p) {
+            if (a.empty() || b.empty())
+                return {};
+
+            UnivariatePolynomial result(a.size() + b.size() - 1, 0);
+            for (size_t i = 0; i < a.size(); i++) {
+                checkCancellation();
+
+                for (size_t j = 0; j < b.size(); j++) {
+                    result[i + j] = addMod(result[i + j], multiplyMod(a[i], b[j], p), p);
+                }
+            }
+
+            trim(result);
+            return result;
+        }
+
+        // divides a by b and stores the remainder in a
+        UnivariatePolynomial divideRemainder(UnivariatePolynomial& a, const UnivariatePolynomial& b, uint64_t p) {
+            if (a.size() < b.size())
+                return {};
+
+            UnivariatePolynomial quotient(a.size() - b.size() + 1, 0);
+            const uint64_t leadInverse = inverseMod(b.back(), p);
+
+            for (size_t i = a.size(); i >= b.size(); i--) {
+                checkCancellation();
+
+                const uint64_t factor = multiplyMod(a[i - 1], leadInverse, p);
+                const size_t shift = i - b.size();
+                quotient[shift] = factor;
+
+                if (factor != 0) {
+                    for (size_t j = 0; j < b.size(); j++) {
+                        a[shift + j] = subtractMod(a[shift + j], multiplyMod(factor, b[j], p), p);
+                    }
+                }
+            }
+
+            trim(a);
+            trim(quotient);
+            return quotient;
+        }
+
+        UnivariatePolynomial makeMonic(UnivariatePolynomial poly, uint64_t p) {
+            if (poly.empty())
+                return poly;
+
+            const uint64_t leadInverse = inverseMod(poly.back(), p);
+            for (uint64_t& coefficient : poly) {
+                coefficient = multiplyMod(coefficient, leadInverse, p);
+            }
+
+            return poly;
+        }
+
+        UnivariatePolynomial gcd(UnivariatePolynomial a, UnivariatePolynomial b, uint64_t p) {
+            while (!b.empty()) {
+                checkCancellation();
+
+                divideRemainder(a, b, p);
+                std::swap(a, b);
+            }
+
+            return makeMonic(a, p);
+        }
+#pragma endregion
+
+#pragma region Multivariate
+        ModularTerms reduce(const Polynomial& poly, uint64_t p) {
+            ModularTerms result;
+            for (const auto& [monomial, coefficient] : poly.getTerms()) {
+                uint64_t value = reduce(coefficient, p);
+                if (value != 0)
+                    result.emplace_hint(result.end(), monomial, value);
+            }
+
+            return result;
+        }
+
+        ModularTerms makeMonic(const ModularTerms& poly, uint64_t p) {
+            ModularTerms result;
+            if (poly.empty())
+                return result;
+
+            const uint64_t leadInverse = inverseMod(poly.begin()->second, p);
+            for (const auto& [monomial, coefficient] : poly) {
+                result.emplace_hint(result.end(), monomial, multiplyMod(coefficient, leadInverse, p));
+            }
+
+            return result;
+        }
+
+        unsigned int degree(const ModularTerms& poly, size_t variable) {
+            unsigned int result = 0;
+            for (const auto& [monomial, coefficient] : poly) {
+                result = std::max(result, monomial[variable]);
+            }
+
+            return result;
+        }
+
+        // interprets the polynomial as a polynomial in the variables before the given variable with univariate coefficients
+        std::map<Monomial, UnivariatePolynomial, std::greater<Monomial>> splitCoefficients(const ModularTerms& poly, size_t variable) {
+            std::map<Monomial, UnivariatePolynomial, std::greater<Monomial>> result;
+
+            for (const auto& [monomial, coefficient] : poly) {
+                Monomial key = monomial;
+                const unsigned int exponent = key[variable];
+                key[variable] = 0;
+
+                UnivariatePolynomial& uni = result[key];
+                if (uni.size() <= exponent)
+                    uni.resize(exponent + 1, 0);
+
+                uni[exponent] = coefficient;
+            }
+
+            return result;
+        }
+
+        ModularTerms joinCoefficients(const std::map<Monomial, UnivariatePolynomial, std::greater<Monomial>>& coefficients, size_t variable) {
+            ModularTerms result;
+
+            for (const auto& [key, uni] : coefficients) {
+                for (size_t exponent = 0; exponent < uni.size(); exponent++) {
+                    if (uni[exponent] == 0)
+                        continue;
+
+                    Monomial monomial = key;
+                    monomial[variable] = static_cast<unsigned int>(exponent);
+                    result.emplace(monomial, uni[exponent]);
+                }
+            }
+
+            return result;
+        }
+
+        ModularTerms evaluate(const ModularTerms& poly, size_t variable, uint64_t value, uint64_t p) {
+            ModularTerms result;
+
+            for (const auto& [monomial, coefficient] : poly) {
+                Monomial key = monomial;
+                const uint64_t factor = multiplyMod(coefficient, powMod(value, key[variable], p), p);
+                key[variable] = 0;
+
+                uint64_t& target = result[key];
+                target = addMod(target, factor, p);
+            }
+
+            std::erase_if(result, [](const auto& term) { return term.second == 0; });
+            return result;
+        }
+
+        ModularTerms multiply(const ModularTerms& a, const ModularTerms& b, uint64_t p) {
+            ModularTerms result;
+
+            for (const auto& [leftMonomial, leftCoefficient] : a) {
+                checkCancellation();
+
+                for (const auto& [rightMonomial, rightCoefficient] : b) {
+                    Monomial product = leftMonomial;
+                    for (size_t i = 0; i < product.size(); i++) {
+                        product[i] += rightMonomial[i];
+                    }
+
+                    uint64_t& target = result[product];
+                    target = addMod(target, multiplyMod(leftCoefficient, rightCoefficient, p), p);
+                }
+            }
+
+            std::erase_if(result, [](const auto& term) { return term.second == 0; });
+            return result;
+        }
+
+        bool divides(const ModularTerms& divisor, ModularTerms remainder, uint64_t p) {
+            const Monomial& lead = divisor.begin()->first;
+            const uint64_t leadInverse = inverseMod(divisor.begin()->second, p);
+
+            while (!remainder.empty()) {
+                checkCancellation();
+
+                const Monomial& remainderLead = remainder.begin()->first;
+
+                Monomial factor(lead.size());
+                for (size_t i = 0; i < lead.size(); i++) {
+                    if (remainderLead[i] < lead[i])
+                        return false;
+
+                    factor[i] = remainderLead[i] - lead[i];
+                }
+
+                const uint64_t factorCoefficient = multiplyMod(remainder.begin()->second, leadInverse, p);
+
+                for (const auto& [monomial, coefficient] : divisor) {
+                    Monomial product = monomial;
+                    for (size_t i = 0; i < product.size(); i++) {
+                        product[i] += factor[i];
+                    }
+
+                    auto it = remainder.find(product);
+                    const uint64_t value = multiplyMod(coefficient, factorCoefficient, p);
+                    if (it == remainder.end()) {
+                        remainder.emplace(product, p - value);
+                    }
+                    else {
+                        it->second = subtractMod(it->second, value, p);
+                        if (it->second == 0)
+                            remainder.erase(it);
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        // computes the monic gcd of a and b in Z_p[x_0, ..., x_{k-1}]
+        ModularTerms gcd(const ModularTerms& a, const ModularTerms& b, size_t k, uint64_t p) {
+            checkCancellation();
+
+            if (a.empty())
+                return makeMonic(b, p);
+            if (b.empty())
+                return makeMonic(a, p);
+
+            const Monomial one(a.begin()->first.size(), 0);
+            if (k == 0)
+                return {{one, 1}};
+
+            const size_t y = k - 1;
+            if (degree(a, y) == 0 && degree(b, y) == 0)
+                return gcd(a, b, k - 1, p);
+
+            auto coefficientsA = splitCoefficients(a, y);
+            auto coefficientsB = splitCoefficients(b, y);
+
+            // content with respect to the main variables
+            UnivariatePolynomial contentA, contentB;
+            for (const auto& [key, uni] : coefficientsA) {
+                contentA = gcd(contentA, uni, p);
+            }
+            for (const auto& [key, uni] : coefficientsB) {
+                contentB = gcd(contentB, uni, p);
+            }
+            const UnivariatePolynomial content = gcd(contentA, contentB, p);
+
+            for (auto& [key, uni] : coefficientsA) {
+                uni = divideRemainder(uni, contentA, p);
+            }
+            for (auto& [key, uni] : coefficientsB) {
+                uni = divideRemainder(uni, contentB, p);
+            }
+
+            // the leading coefficients of the primitive parts determine the leading coefficient of the gcd
+            const UnivariatePolynomial& leadA = coefficientsA.begin()->second;
+            const UnivariatePolynomial& leadB = coefficientsB.begin()->second;
+            const UnivariatePolynomial leadGcd = gcd(leadA, leadB, p);
+
+            const ModularTerms primitiveA = joinCoefficients(coefficientsA, y);
+            const ModularTerms primitiveB = joinCoefficients(coefficientsB, y);
+
+            const size_t bound = std::min(degree(primitiveA, y), degree(primitiveB, y)) + leadGcd.size();
+
+            std::map<Monomial, UnivariatePolynomial, std::greater<Monomial>> interpolated;
+            Monomial interpolatedLead;
+            UnivariatePolynomial modulus;
+            size_t points = 0;
+
+            for (uint64_t alpha = 1; alpha < p; alpha++) {
+                checkCancellation();
+
+                const uint64_t leadValue = evaluate(leadGcd, alpha, p);
+                if (leadValue == 0 || evaluate(leadA, alpha, p) == 0 || evaluate(leadB, alpha, p) == 0)
+                    continue;
+
+                ModularTerms image = gcd(evaluate(primitiveA, y, alpha, p), evaluate(primitiveB, y, alpha, p), k - 1, p);
+                for (auto& [monomial, coefficient] : image) {
+                    coefficient = multiplyMod(coefficient, leadValue, p);
+                }
+
+                const Monomial& imageLead = image.begin()->first;
+                bool changed = true;
+
+                if (points == 0 || imageLead < interpolatedLead) {
+                    // all previous evaluation points were unlucky
+                    interpolated.clear();
+                    for (const auto& [monomial, coefficient] : image) {
+                        interpolated[monomial] = {coefficient};
+                    }
+
+                    interpolatedLead = imageLead;
+                    modulus = {p - alpha, 1};
+                    points = 1;
+                }
+                else if (interpolatedLead < imageLead) {
+                    // unlucky evaluation point
+                    continue;
+                }
+                else {
+                    // newton interpolation: h = h + (image - h(alpha)) * m / m(alpha)
+                    const uint64_t modulusInverse = inverseMod(evaluate(modulus, alpha, p), p);
+                    changed = false;
+
+                    for (const auto& [monomial, coefficient] : image) {
+                        interpolated.try_emplace(monomial);
+                    }
+
+                    for (auto& [monomial, uni] : interpolated) {
+                        auto it = image.find(monomial);
+                        const uint64_t target = it == image.end() ? 0 : it->second;
+                        const uint64_t difference = subtractMod(target, evaluate(uni, alpha, p), p);
+
+                        if (difference != 0) {
+                            const uint64_t factor = multiplyMod(difference, modulusInverse, p);
+                            if (uni.size() < modulus.size())
+                                uni.resize(modulus.size(), 0);
+
+                            for (size_t i = 0; i < modulus.size(); i++) {
+                                uni[i] = addMod(uni[i], multiplyMod(modulus[i], factor, p), p);
+                            }
+
+                            trim(uni);
+                            changed = true;
+                        }
+                    }
+
+                    std::erase_if(interpolated, [](const auto& term) { return term.second.empty(); });
+                    modulus = multiply(modulus, {p - alpha, 1}, p);
+                    points++;
+                }
+
+                if (points < bound && changed)
+                    continue;
+
+                // remove the content in y that was introduced by the leading coefficient scaling
+                UnivariatePolynomial candidateContent;
+                for (const auto& [monomial, uni] : interpolated) {
+                    candidateContent = gcd(candidateContent, uni, p);
+                }
+
+                auto candidateCoefficients = interpolated;
+                for (auto& [monomial, uni] : candidateCoefficients) {
+                    uni = divideRemainder(uni, candidateContent, p);
+                }
+
+                const ModularTerms candidate = joinCoefficients(candidateCoefficients, y);
+                if (divides(candidate, primitiveA, p) && divides(candidate, primitiveB, p)) {
+                    std::map<Monomial, UnivariatePolynomial, std::greater<Monomial>> contentPolynomial = {{one, content}};
+
+                    return makeMonic(multiply(candidate, joinCoefficients(contentPolynomial, y), p), p);
+                }
+
+                if (points >= bound) {
+                    // the interpolation used an unlucky evaluation point, start again
+                    points = 0;
+                }
+            }
+
+            throw std::runtime_error("Modular gcd ran out of evaluation points");
+        }
+#pragma endregion
+    } // namespace
+
+    Polynomial gcd(const Polynomial& a, const Polynomial& b) {
+        const size_t variableCount = a.getVariableCount();
+
+        if (a.isZero())
+            return b.primitivePart().scale(gcd(b.content(), 0));
+        if (b.isZero())
+            return a.primitivePart().scale(gcd(a.content(), 0));
+
+        const int64_t contentGcd = gcd(a.content(), b.content());
+        const Polynomial primitiveA = a.primitivePart();
+        const Polynomial primitiveB = b.primitivePart();
+
+        if (primitiveA.isConstant() || primitiveB.isConstant())
+            return Polynomial::constant(variableCount, contentGcd);
+
+        if (primitiveA == primitiveB)
+            return primitiveA.scale(contentGcd);
+
+        // the leading coefficient of the gcd divides the gcd of the leading coefficients
+        const int64_t leadGcd = gcd(primitiveA.leadingCoefficient(), primitiveB.leadingCoefficient());
+
+        static const std::vector<uint64_t> primes = getPrimes();
+
+        // the coefficients are stored as mixed radix digits in the symmetric range with respect to the used primes
+        std::map<Monomial, std::vector<int64_t>, std::greater<Monomial>> digits;
+        std::vector<uint64_t> usedPrimes;
+        Monomial lead;
+
+        for (uint64_t p : primes) {
+            checkCancellation();
+
+            if (reduce(primitiveA.leadingCoefficient(), p) == 0 || reduce(primitiveB.leadingCoefficient(), p) == 0)
+                continue;
+
+            ModularTerms image = gcd(reduce(primitiveA, p), reduce(primitiveB, p), variableCount, p);
+            const uint64_t leadValue = reduce(leadGcd, p);
+            for (auto& [monomial, coefficient] : image) {
+                coefficient = multiplyMod(coefficient, leadValue, p);
+            }
+
+            const Monomial& imageLead = image.begin()->first;
+            bool changed = false;
+
+            if (usedPrimes.empty() || imageLead < lead) {
+                digits.clear();
+                usedPrimes.clear();
+
+                for (const auto& [monomial, coefficient] : image) {
+                    digits[monomial] = {symmetric(coefficient, p)};
+                }
+
+                lead = imageLead;
+                changed = true;
+            }
+            else if (lead < imageLead) {
+                // unlucky prime
+                continue;
+            }
+            else {
+                // garner's algorithm: append the next mixed radix digit
+                uint64_t radix = 1;
+                for (uint64_t usedPrime : usedPrimes) {
+                    radix = multiplyMod(radix, usedPrime % p, p);
+                }
+                const uint64_t radixInverse = inverseMod(radix, p);
+
+                for (const auto& [monomial, coefficient] : image) {
+                    digits.try_emplace(monomial, std::vector<int64_t>(usedPrimes.size(), 0));
+                }
+
+                for (auto& [monomial, monomialDigits] : digits) {
+                    uint64_t value = 0;
+                    uint64_t factor = 1;
+                    for (size_t i = 0; i < monomialDigits.size(); i++) {
+                        value = addMod(value, multiplyMod(reduce(monomialDigits[i], p), factor, p), p);
+                        factor = multiplyMod(factor, usedPrimes[i] % p, p);
+                    }
+
+                    auto it = image.find(monomial);
+                    const uint64_t target = it == image.end() ? 0 : it->second;
+                    const int64_t digit = symmetric(multiplyMod(subtractMod(target, value, p), radixInverse, p), p);
+
+                    monomialDigits.push_back(digit);
+                    changed |= digit != 0;
+                }
+            }
+
+            usedPrimes.push_back(p);
+            if (changed && usedPrimes.size() > 1)
+                continue;
+
+            // reconstruct the integer coefficients
+            Polynomial candidate(variableCount);
+            try {
+                for (const auto& [monomial, monomialDigits] : digits) {
+                    int64_t value = 0;
+                    int64_t factor = 1;
+                    for (size_t i = 0; i < monomialDigits.size(); i++) {
+                        if (monomialDigits[i] != 0)
+                            value = checkedAdd(value, checkedMultiply(monomialDigits[i], factor));
+
+                        if (i + 1 < monomialDigits.size())
+                            factor = checkedMultiply(factor, static_cast<int64_t>(usedPrimes[i]));
+                    }
+
+                    candidate.addTerm(monomial, value);
+                }
+            }
+            catch (const polynomial_overflow_error&) {
+                throw polynomial_overflow_error("The coefficients of the gcd exceed the supported integer range");
+            }
+
+            if (candidate.isZero())
+                continue;
+
+            const Polynomial primitiveCandidate = candidate.primitivePart();
+            if (primitiveCandidate.divides(primitiveA) && primitiveCandidate.divides(primitiveB)) {
+                return primitiveCandidate.scale(contentGcd);
+            }
+        }
+
+        throw polynomial_overflow_error("The coefficients of the gcd exceed the supported integer range");
+    }
+} // namespace cas::math
@@ -0,0 +1,261 @@
+#include "algebra/polynomial.hpp"
+
+#include "checkedArithmetic.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <cstdlib>
+
+namespace cas::math {
+    polynomial_overflow_error::polynomial_overflow_error(const std::string& message)
+        : std::overflow_error(message) {
+    }
+
+    Polynomial::Polynomial(size_t variableCount)
+        : variableCount(variableCount) {
+    }
+
+    Polynomial Polynomial::constant(size_t variableCount, int64_t value) {
+        Polynomial result(variableCount);
+        result.addTerm(Monomial(variableCount, 0), value);
+
+        return result;
+    }
+
+    Polynomial Polynomial::variable(size_t variableCount, size_t index) {
+        Monomial monomial(variableCount, 0);
+        monomial[index] = 1;
+
+        Polynomial result(variableCount);
+        result.addTerm(monomial, 1);
+
+        return result;
+    }
+
+    size_t Polynomial::getVariableCount() const {
+        return variableCount;
+    }
+
+    const Polynomial::Terms& Polynomial::getTerms() const {
+        return terms;
+    }
+
+    bool Polynomial::isZero() const {
+        return terms.empty();
+    }
+
+    bool Polynomial::isConstant() const {
+        if (terms.empty())
+            return true;
+
+        if (terms.size() > 1)
+            return false;
+
+        for (unsigned int exponent : terms.begin()->first) {
+            if (exponent != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    const Monomial& Polynomial::leadingMonomial() const {
+        return terms.begin()->first;
+    }
+
+    int64_t Polynomial::leadingCoefficient() const {
+        return terms.empty() ? 0 : terms.begin()->second;
+    }
+
+    unsigned int Polynomial::degree(size_t variable) const {
+        unsigned int result = 0;
+        for (const auto& [monomial, coefficient] : terms) {
+            result = std::max(result, monomial[variable]);
+        }
+
+        return result;
+    }
+
+    int64_t Polynomial::content() const {
+        int64_t result = 0;
+        for (const auto& [monomial, coefficient] : terms) {
+            result = gcd(result, coefficient);
+
+            if (result == 1)
+                break;
+        }
+
+        // the content carries the sign of the leading coefficient, so the primitive part has a positive leading coefficient
+        if (leadingCoefficient() < 0)
+            return -result;
+
+        return result;
+    }
+
+    Polynomial Polynomial::primitivePart() const {
+        if (terms.empty())
+            return *this;
+
+        return divideScalar(content());
+    }
+
+    void Polynomial::addTerm(const Monomial& monomial, int64_t coefficient) {
+        if (coefficient == 0)
+            return;
+
+        auto it = terms.find(monomial);
+        if (it == terms.end()) {
+            terms.emplace(monomial, coefficient);
+            return;
+        }
+
+        it->second = checkedAdd(it->second, coefficient);
+        if (it->second == 0) {
+            terms.erase(it);
+        }
+    }
+
+    Polynomial Polynomial::scale(int64_t factor) const {
+        Polynomial result(variableCount);
+        if (factor == 0)
+            return result;
+
+        for (const auto& [monomial, coefficient] : terms) {
+            result.terms.emplace_hint(result.terms.end(), monomial, checkedMultiply(coefficient, factor));
+        }
+
+        return result;
+    }
+
+    Polynomial Polynomial::divideScalar(int64_t divisor) const {
+        Polynomial result(variableCount);
+        for (const auto& [monomial, coefficient] : terms) {
+            result.terms.emplace_hint(result.terms.end(), monomial, coefficient / divisor);
+        }
+
+        return result;
+    }
+
+    Polynomial Polynomial::pow(unsigned int exponent) const {
+        // square and multiply
+        Polynomial result = constant(variableCount, 1);
+        Polynomial base = *this;
+
+        while (exponent > 0) {
+            if (exponent & 1)
+                result = result * base;
+
+            exponent >>= 1;
+            if (exponent > 0)
+                base = base * base;
+        }
+
+        return result;
+    }
+
+    bool Polynomial::divides(const Polynomial& dividend, Polynomial* quotient) const {
+        checkCancellation();
+
+        if (terms.empty())
+            return false;
+
+        Polynomial remainder = dividend;
+        Polynomial result(variableCount);
+
+        const Monomial& lead = leadingMonomial();
+        const int64_t leadCoefficient = leadingCoefficient();
+
+        while (!remainder.isZero()) {
+            checkCancellation();
+
+            // in lexicographic order the leading term of the divisor has to divide the leading term of the remainder
+            const Monomial& remainderLead = remainder.leadingMonomial();
+            const int64_t remainderCoefficient = remainder.leadingCoefficient();
+
+            if (remainderCoefficient % leadCoefficient != 0)
+                return false;
+
+            Monomial factor(variableCount);
+            for (size_t i = 0; i < variableCount; i++) {
+                if (remainderLead[i] < lead[i])
+                    return false;
+
+                factor[i] = remainderLead[i] - lead[i];
+            }
+
+            const int64_t factorCoefficient = remainderCoefficient / leadCoefficient;
+            result.addTerm(factor, factorCoefficient);
+
+            for (const auto& [monomial, coefficient] : terms) {
+                Monomial product = monomial;
+                for (size_t i = 0; i < variableCount; i++) {
+                    product[i] += factor[i];
+                }
+
+                remainder.addTerm(product, -checkedMultiply(coefficient, factorCoefficient));
+            }
+        }
+
+        if (quotient != nullptr)
+            *quotient = result;
+
+        return true;
+    }
+
+    Polynomial Polynomial::operator-() const {
+        return scale(-1);
+    }
+
+    Polynomial Polynomial::operator+(const Polynomial& other) const {
+        Polynomial result = *this;
+        for (const auto& [monomial, coefficient] : other.terms) {
+            result.addTerm(monomial, coefficient);
+        }
+
+        return result;
+    }
+
+    Polynomial Polynomial::operator-(const Polynomial& other) const {
+        Polynomial result = *this;
+        for (const auto& [monomial, coefficient] : other.terms) {
+            result.addTerm(monomial, checkedMultiply(coefficient, -1));
+        }
+
+        return result;
+    }
+
+    Polynomial Polynomial::operator*(const Polynomial& other) const {
+        checkCancellation();
+
+        Polynomial result(variableCount);
+
+        for (const auto& [leftMonomial, leftCoefficient] : terms) {
+            for (const auto& [rightMonomial, rightCoefficient] : other.terms) {
+                Monomial product = leftMonomial;
+                for (size_t i = 0; i < variableCount; i++) {
+                    product[i] += rightMonomial[i];
+                }
+
+                result.addTerm(product, checkedMultiply(leftCoefficient, rightCoefficient));
+            }
+        }
+
+        return result;
+    }
+
+    bool Polynomial::operator==(const Polynomial& other) const {
+        return variableCount == other.variableCount && terms == other.terms;
+    }
+
+    int64_t gcd(int64_t a, int64_t b) {
+        a = std::abs(a);
+        b = std::abs(b);
+
+        while (b != 0) {
+            int64_t tmp = a % b;
+            a = b;
+            b = tmp;
+        }
+
+        return a;
+    }
+} // namespace cas::math
@@ -0,0 +1,351 @@
+#include "algebra/rationalFunction.hpp"
+
+#include "expressions/expressions.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cas::math {
+    namespace {
+        constexpr double maxExactInteger = 9007199254740992.0; // 2^53
+        constexpr int maxExponent = 1024;
+
+        bool getInteger(const Expression* expr, int64_t& value) {
+            if (expr->getType() != ExpressionTypes::Constant)
+                return false;
+
+            if (const Complex* complex = dynamic_cast<const Complex*>(expr)) {
+                if (complex->imaginary != 0)
+                    return false;
+            }
+
+            const double realValue = static_cast<const Number*>(expr)->realValue;
+            if (!std::isfinite(realValue) || std::floor(realValue) != realValue || std::abs(realValue) >= maxExactInteger)
+                return false;
+
+            value = static_cast<int64_t>(realValue);
+            return true;
+        }
+
+        // numbers with a small power of two as denominator are represented exactly
+        bool getRational(const Expression* expr, int64_t& numerator, int64_t& denominator) {
+            if (getInteger(expr, numerator)) {
+                denominator = 1;
+                return true;
+            }
+
+            if (expr->getType() != ExpressionTypes::Constant || dynamic_cast<const Complex*>(expr) != nullptr)
+                return false;
+
+            double value = static_cast<const Number*>(expr)->realValue;
+            if (!std::isfinite(value))
+                return false;
+
+            for (int shift = 1; shift <= 20; shift++) {
+                value *= 2;
+                if (std::floor(value) == value && std::abs(value) < maxExactInteger) {
+                    numerator = static_cast<int64_t>(value);
+                    denominator = int64_t(1) << shift;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool getExponent(const Exponentiation* exp, int& exponent) {
+            int64_t value;
+            if (!getInteger(exp->right, value) || std::abs(value) > maxExponent)
+                return false;
+
+            exponent = static_cast<int>(value);
+            return true;
+        }
+
+        std::string getKernelKey(const Expression* expr) {
+            // variables are sorted in front of the other kernels
+            if (expr->getType() == ExpressionTypes::Variable)
+                return "0" + expr->toString();
+
+            return "1" + expr->toString();
+        }
+
+        Expression* buildSum(std::vector<Expression*>& summands) {
+            auto it = summands.rbegin();
+            Expression* result = *it;
+            it++;
+
+            while (it != summands.rend()) {
+                result = new Addition(*it, result);
+                it++;
+            }
+
+            return result;
+        }
+    } // namespace
+
+    not_polynomial_error::not_polynomial_error(const std::string& message)
+        : std::runtime_error(message) {
+    }
+
+#pragma region RationalFunction
+    RationalFunction::RationalFunction(const Polynomial& numerator)
+        : numerator(numerator), denominator(Polynomial::constant(numerator.getVariableCount(), 1)) {
+    }
+
+    RationalFunction::RationalFunction(const Polynomial& numerator, const Polynomial& denominator)
+        : numerator(numerator), denominator(denominator) {
+        cancel();
+    }
+
+    void RationalFunction::cancel() {
+        if (denominator.isZero())
+            throw std::runtime_error("Division by zero");
+
+        if (numerator.isZero()) {
+            denominator = Polynomial::constant(numerator.getVariableCount(), 1);
+            return;
+        }
+
+        Polynomial divisor = gcd(numerator, denominator);
+        if (denominator.leadingCoefficient() < 0)
+            divisor = -divisor;
+
+        divisor.divides(numerator, &numerator);
+        divisor.divides(denominator, &denominator);
+    }
+
+    const Polynomial& RationalFunction::getNumerator() const {
+        return numerator;
+    }
+
+    const Polynomial& RationalFunction::getDenominator() const {
+        return denominator;
+    }
+
+    bool RationalFunction::isPolynomial() const {
+        return denominator.isConstant() && denominator.leadingCoefficient() == 1;
+    }
+
+    RationalFunction RationalFunction::pow(int exponent) const {
+        if (exponent < 0) {
+            return RationalFunction(denominator.pow(-exponent), numerator.pow(-exponent));
+        }
+
+        RationalFunction result = RationalFunction(numerator.pow(exponent));
+        result.denominator = denominator.pow(exponent);
+
+        return result;
+    }
+
+    RationalFunction RationalFunction::operator+(const RationalFunction& other) const {
+        if (denominator == other.denominator) {
+            return RationalFunction(numerator + other.numerator, denominator);
+        }
+
+        // use the least common multiple of the denominators
+        Polynomial denominatorGcd = gcd(denominator, other.denominator);
+        Polynomial leftFactor, rightFactor;
+        denominatorGcd.divides(other.denominator, &leftFactor);
+        denominatorGcd.divides(denominator, &rightFactor);
+
+        return RationalFunction(numerator * leftFactor + other.numerator * rightFactor, denominator * leftFactor);
+    }
+
+    RationalFunction RationalFunction::operator*(const RationalFunction& other) const {
+        if (isPolynomial() && other.isPolynomial()) {
+            return RationalFunction(numerator * other.numerator);
+        }
+
+        return RationalFunction(numerator * other.numerator, denominator * other.denominator);
+    }
+#pragma endregion
+
+#pragma region PolynomialMapping
+    PolynomialMapping::~PolynomialMapping() {
+        for (Expression* kernel : kernels) {
+            delete kernel;
+        }
+    }
+
+    void PolynomialMapping::addKernel(const Expression* expr) {
+        const std::string key = getKernelKey(expr);
+
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        if (it != keys.end() && *it == key)
+            return;
+
+        kernels.insert(kernels.begin() + (it - keys.begin()), expr->copy());
+        keys.insert(it, key);
+    }
+
+    size_t PolynomialMapping::getKernelIndex(const Expression* expr) const {
+        const std::string key = getKernelKey(expr);
+
+        auto it = std::lower_bound(keys.begin(), keys.end(), key);
+        if (it == keys.end() || *it != key)
+            throw std::runtime_error("Unknown kernel " + expr->toString());
+
+        return it - keys.begin();
+    }
+
+    void PolynomialMapping::collect(const Expression* expr) {
+        int64_t numerator, denominator;
+        int exponent;
+
+        switch (expr->getType()) {
+            case ExpressionTypes::Addition:
+            case ExpressionTypes::Multiplication:
+                for (const Expression* child : expr->getChildren()) {
+                    collect(child);
+                }
+                return;
+            case ExpressionTypes::Exponentiation:
+                if (getExponent(static_cast<const Exponentiation*>(expr), exponent)) {
+                    collect(static_cast<const Exponentiation*>(expr)->left);
+                    return;
+                }
+                break;
+            case ExpressionTypes::Constant:
+                if (getRational(expr, numerator, denominator))
+                    return;
+                break;
+            default: break;
+        }
+
+        addKernel(expr);
+    }
+
+    size_t PolynomialMapping::getVariableCount() const {
+        return kernels.size();
+    }
+
+    Polynomial PolynomialMapping::toPolynomial(const Expression* expr) const {
+        const size_t variableCount = getVariableCount();
+        int64_t value;
+        int exponent;
+
+        switch (expr->getType()) {
+            case ExpressionTypes::Addition: {
+                const Addition* addition = static_cast<const Addition*>(expr);
+                return toPolynomial(addition->left) + toPolynomial(addition->right);
+            }
+            case ExpressionTypes::Multiplication: {
+                const Multiplication* multiplication = static_cast<const Multiplication*>(expr);
+                return toPolynomial(multiplication->left) * toPolynomial(multiplication->right);
+            }
+            case ExpressionTypes::Exponentiation: {
+                const Exponentiation* exp = static_cast<const Exponentiation*>(expr);
+                if (getExponent(exp, exponent)) {
+                    if (exponent < 0)
+                        throw not_polynomial_error(expr->toString() + " is not a polynomial");
+
+                    return toPolynomial(exp->left).pow(exponent);
+                }
+            } break;
+            case ExpressionTypes::Constant:
+                if (getInteger(expr, value))
+                    return Polynomial::constant(variableCount, value);
+
+                int64_t numerator, denominator;
+                if (getRational(expr, numerator, denominator))
+                    throw not_polynomial_error(expr->toString() + " is not an integer");
+                break;
+            default: break;
+        }
+
+        return Polynomial::variable(variableCount, getKernelIndex(expr));
+    }
+
+    RationalFunction PolynomialMapping::toRationalFunction(const Expression* expr) const {
+        const size_t variableCount = getVariableCount();
+        int64_t numerator, denominator;
+        int exponent;
+
+        switch (expr->getType()) {
+            case ExpressionTypes::Addition: {
+                const Addition* addition = static_cast<const Addition*>(expr);
+                return toRationalFunction(addition->left) + toRationalFunction(addition->right);
+            }
+            case ExpressionTypes::Multiplication: {
+                const Multiplication* multiplication = static_cast<const Multiplication*>(expr);
+                return toRationalFunction(multiplication->left) * toRationalFunction(multiplication->right);
+            }
+            case ExpressionTypes::Exponentiation: {
+                const Exponentiation* exp = static_cast<const Exponentiation*>(expr);
+                if (getExponent(exp, exponent))
+                    return toRationalFunction(exp->left).pow(exponent);
+            } break;
+            case ExpressionTypes::Constant:
+                if (getRational(expr, numerator, denominator))
+                    return RationalFunction(Polynomial::constant(variableCount, numerator), Polynomial::constant(variableCount, denominator));
+                break;
+            default: break;
+        }
+
+        return RationalFunction(Polynomial::variable(variableCount, getKernelIndex(expr)));
+    }
+
+    Expression* PolynomialMapping::toExpression(const Polynomial& poly) const {
+        if (poly.isZero())
+            return new Number(0);
+
+        std::vector<Expression*> summands;
+        summands.reserve(poly.getTerms().size());
+
+        for (const auto& [monomial, coefficient] : poly.getTerms()) {
+            std::vector<Expression*> factors;
+
+            for (size_t i = 0; i < monomial.size(); i++) {
+                if (monomial[i] == 0)
+                    continue;
+
+                if (monomial[i] == 1)
+                    factors.push_back(kernels[i]->copy());
+                else
+                    factors.push_back(new Exponentiation(kernels[i]->copy(), new Number(monomial[i])));
+            }
+
+            if (factors.empty()) {
+                summands.push_back(new Number(static_cast<double>(coefficient)));
+                continue;
+            }
+
+            Expression* term = factors.back();
+            for (auto it = factors.rbegin() + 1; it != factors.rend(); it++) {
+                term = new Multiplication(*it, term);
+            }
+
+            if (coefficient != 1)
+                term = new Multiplication(new Number(static_cast<double>(coefficient)), term);
+
+            summands.push_back(term);
+        }
+
+        return buildSum(summands);
+    }
+
+    Expression* PolynomialMapping::toExpression(const RationalFunction& function) const {
+        Expression* numerator = toExpression(function.getNumerator());
+        if (function.isPolynomial())
+            return numerator;
+
+        return new Multiplication(numerator, new Exponentiation(toExpression(function.getDenominator()), new Number(-1)));
+    }
+#pragma endregion
+
+    Expression* cancel(const Expression* expr) {
+        PolynomialMapping mapping;
+        mapping.collect(expr);
+
+        return mapping.toExpression(mapping.toRationalFunction(expr));
+    }
+
+    Expression* polynomialGcd(const Expression* a, const Expression* b) {
+        PolynomialMapping mapping;
+        mapping.collect(a);
+        mapping.collect(b);
+
+        return mapping.toExpression(gcd(mapping.toPolynomial(a), mapping.toPolynomial(b)));
+    }
+} // namespace cas::math
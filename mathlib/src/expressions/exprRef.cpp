@@ -0,0 +1,60 @@
+#include "expressions/exprRef.hpp"
+
+namespace cas::math {
+    ExprRef::ExprRef(Expression* expr) {
+        if (expr == nullptr)
+            return;
+
+        if (expr->parent != nullptr)
+            expr = expr->copy();
+
+        expression = std::shared_ptr<const Expression>(expr, Deleter());
+    }
+
+    ExprRef::ExprRef(const FrozenExpression& expr)
+        : expression(expr.expression) {
+    }
+
+    ExprRef ExprRef::copyOf(const Expression* expr) {
+        return ExprRef(expr == nullptr ? nullptr : expr->copy());
+    }
+
+    const Expression* ExprRef::get() const {
+        return expression.get();
+    }
+
+    const Expression* ExprRef::operator->() const {
+        return expression.get();
+    }
+
+    const Expression& ExprRef::operator*() const {
+        return *expression;
+    }
+
+    ExprRef::operator bool() const {
+        return expression != nullptr;
+    }
+
+    long ExprRef::getUseCount() const {
+        return expression.use_count();
+    }
+
+    Expression* ExprRef::take() {
+        if (expression == nullptr)
+            return nullptr;
+
+        // no other handle can add a reference to the tree, so it can be moved out. Trees of frozen expressions have
+        // another deleter and are never moved
+        Deleter* deleter = std::get_deleter<Deleter>(expression);
+        if (deleter != nullptr && expression.use_count() == 1) {
+            Expression* expr = const_cast<Expression*>(expression.get());
+            deleter->released = true;
+            expression.reset();
+            return expr;
+        }
+
+        Expression* expr = expression->copy();
+        expression.reset();
+        return expr;
+    }
+} // namespace cas::math
@@ -0,0 +1,105 @@
+#include "expressions/expressionHash.hpp"
+
+#include "expressions/expressions.hpp"
+
+#include <functional>
+
+namespace cas::math {
+    namespace {
+        inline size_t combine(size_t seed, size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+        }
+
+        // hash of the node without its children
+        size_t hashNode(const Expression* expr) {
+            size_t hash = static_cast<size_t>(expr->getType());
+
+            switch (expr->getType()) {
+                case ExpressionTypes::Constant: {
+                    hash = combine(hash, std::hash<double>{}(static_cast<const Number*>(expr)->realValue));
+
+                    const Complex* complex = dynamic_cast<const Complex*>(expr);
+                    if (complex != nullptr)
+                        hash = combine(hash, std::hash<double>{}(complex->imaginary));
+                } break;
+                case ExpressionTypes::NamedConstant:
+                    hash = combine(hash, std::hash<std::string>{}(expr->toString()));
+                    break;
+                case ExpressionTypes::Variable:
+                case ExpressionTypes::Differential:
+                    hash = combine(hash, std::hash<std::string>{}(static_cast<const Variable*>(expr)->getSymbol()));
+                    break;
+                case ExpressionTypes::Function:
+                    hash = combine(hash, std::hash<std::string>{}(static_cast<const BaseFunction*>(expr)->name));
+                    break;
+                default:
+                    break;
+            }
+
+            return hash;
+        }
+
+        bool equalNodes(const Expression* lhs, const Expression* rhs) {
+            if (lhs->getType() != rhs->getType())
+                return false;
+
+            switch (lhs->getType()) {
+                case ExpressionTypes::Constant: {
+                    const Complex* lhsComplex = dynamic_cast<const Complex*>(lhs);
+                    const Complex* rhsComplex = dynamic_cast<const Complex*>(rhs);
+
+                    const double lhsImaginary = lhsComplex != nullptr ? lhsComplex->imaginary : 0;
+                    const double rhsImaginary = rhsComplex != nullptr ? rhsComplex->imaginary : 0;
+                    return static_cast<const Number*>(lhs)->realValue == static_cast<const Number*>(rhs)->realValue &&
+                           lhsImaginary == rhsImaginary;
+                }
+                case ExpressionTypes::NamedConstant:
+                    return lhs->toString() == rhs->toString();
+                case ExpressionTypes::Variable:
+                case ExpressionTypes::Differential:
+                    return static_cast<const Variable*>(lhs)->getSymbol() == static_cast<const Variable*>(rhs)->getSymbol();
+                case ExpressionTypes::Function:
+                    return static_cast<const BaseFunction*>(lhs)->name == static_cast<const BaseFunction*>(rhs)->name;
+                default:
+                    return true;
+            }
+        }
+    } // namespace
+
+    size_t hashExpression(const Expression* expr) {
+        size_t hash = hashNode(expr);
+
+        for (const Expression* child : expr->getChildren()) {
+            hash = combine(hash, hashExpression(child));
+        }
+
+        return hash;
+    }
+
+    bool equalExpressions(const Expression* lhs, const Expression* rhs) {
+        if (!equalNodes(lhs, rhs))
+            return false;
+
+        const std::vector<Expression*> lhsChildren = lhs->getChildren();
+        const std::vector<Expression*> rhsChildren = rhs->getChildren();
+        if (lhsChildren.size() != rhsChildren.size())
+            return false;
+
+        for (size_t i = 0; i < lhsChildren.size(); i++) {
+            if (!equalExpressions(lhsChildren[i], rhsChildren[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    size_t countNodes(const Expression* expr) {
+        size_t count = 1;
+
+        for (const Expression* child : expr->getChildren()) {
+            count += countNodes(child);
+        }
+
+        return count;
+    }
+} // namespace cas::math
@@ -1,8 +1,45 @@
 #include "expressions/expressionMatcher.hpp"
 
 #include "expressions/expressions.hpp"
+#include "expressions/resourceBudget.hpp"
+#include "parallel/cancellation.hpp"
+#include "parallel/taskGroup.hpp"
+
+#include <functional>
+#include <mutex>
 
 namespace cas::math {
+    namespace {
+        // counts down the remaining nodes and stops as soon as the tree is known to be larger
+        bool hasMoreNodes(const Expression* expr, size_t& remaining) {
+            if (remaining == 0)
+                return true;
+
+            remaining--;
+            for (const Expression* child : expr->getChildren()) {
+                if (hasMoreNodes(child, remaining))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // ends[i] is the index after the last node of the subtree of nodes[i]
+        void flatten(Expression* expr, std::vector<Expression*>& nodes, std::vector<size_t>& ends) {
+            DepthGuard depthGuard;
+
+            const size_t index = nodes.size();
+            nodes.push_back(expr);
+            ends.push_back(0);
+
+            for (Expression* child : expr->getChildren()) {
+                flatten(child, nodes, ends);
+            }
+
+            ends[index] = nodes.size();
+        }
+    } // namespace
+
     ExpressionMatch::ExpressionMatch(bool success, Expression* node, std::map<VariableSymbol, Expression*> variables)
         : success(success), node(node) {
         for (const auto [var, expr] : variables) {
@@ -12,6 +49,10 @@ namespace cas::math {
 
     ExpressionMatch::ExpressionMatch(const ExpressionMatch& other)
         : ExpressionMatch(other.success, other.node, other.variables) {
+        if (other.ownsNode) {
+            node = other.node->copy();
+            ownsNode = true;
+        }
     }
 
     ExpressionMatch::~ExpressionMatch() {
@@ -20,6 +61,17 @@ namespace cas::math {
         }
 
         variables.clear();
+
+        if (ownsNode)
+            delete node;
+    }
+
+    void ExpressionMatch::detach() {
+        if (node == nullptr || ownsNode)
+            return;
+
+        node = node->copy();
+        ownsNode = true;
     }
 
     ExpressionMatch& ExpressionMatch::operator=(const ExpressionMatch& other) {
@@ -28,7 +80,12 @@ namespace cas::math {
         }
 
         success = other.success;
-        node = other.node;
+
+        if (ownsNode)
+            delete node;
+        node = other.ownsNode ? other.node->copy() : other.node;
+        ownsNode = other.ownsNode;
+
         for (const auto [var, expr] : variables) {
             delete expr;
         }
@@ -70,6 +127,9 @@ namespace cas::math {
     }
 
     bool ExpressionMatcher::matches(Expression* expr, Expression* pattern) {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         switch (pattern->getType()) {
             case ExpressionTypes::Constant: {
                 try {
@@ -105,6 +165,9 @@ namespace cas::math {
     }
 
     ExpressionMatch ExpressionMatcher::match(Expression* expr, Expression* pattern, bool recurse, std::map<VariableSymbol, Expression*> variables) {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         switch (pattern->getType()) {
             case ExpressionTypes::Constant: {
                 try {
@@ -233,7 +296,10 @@ namespace cas::math {
         return ExpressionMatch(false, nullptr);
     }
 
-    std::vector<ExpressionMatch> ExpressionMatcher::matchAll(Expression* expr, Expression* pattern) {
+    std::vector<ExpressionMatch> ExpressionMatcher::matchAllSequential(Expression* expr, Expression* pattern) {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         ExpressionMatch thisMatch = match(expr, pattern);
 
         if (thisMatch.success) {
@@ -243,7 +309,7 @@ namespace cas::math {
         std::vector<Expression*> children = expr->getChildren();
         std::vector<ExpressionMatch> result;
         for (Expression* child : children) {
-            std::vector<ExpressionMatch> subMatch = matchAll(child, pattern);
+            std::vector<ExpressionMatch> subMatch = matchAllSequential(child, pattern);
 
             result.insert(result.end(), subMatch.begin(), subMatch.end());
         }
@@ -251,6 +317,63 @@ namespace cas::math {
         return result;
     }
 
+    std::vector<ExpressionMatch> ExpressionMatcher::matchAll(Expression* expr, Expression* pattern) {
+        size_t remaining = parallelThreshold;
+        if (!hasMoreNodes(expr, remaining))
+            return matchAllSequential(expr, pattern);
+
+        return matchAllParallel(expr, pattern);
+    }
+
+    std::vector<ExpressionMatch> ExpressionMatcher::matchAllParallel(Expression* expr, Expression* pattern, size_t threshold) {
+        // the tree is flattened in preorder, so the size of every subtree is known without counting again
+        std::vector<Expression*> nodes;
+        std::vector<size_t> ends;
+        flatten(expr, nodes, ends);
+
+        // the matches of every task are stored with the preorder index of its subtree. The subtrees of the tasks are
+        // disjoint, so concatenating them in the order of the indices yields the matches in preorder
+        std::mutex resultsMutex;
+        std::map<size_t, std::vector<ExpressionMatch>> results;
+
+        TaskGroup group;
+        std::function<void(size_t)> searchSubtree = [&](size_t index) {
+            checkCancellation();
+
+            std::vector<ExpressionMatch> matches;
+            if (ends[index] - index <= threshold) {
+                matches = matchAllSequential(nodes[index], pattern);
+            }
+            else {
+                ExpressionMatch thisMatch = match(nodes[index], pattern);
+
+                if (thisMatch.success) {
+                    matches.push_back(thisMatch);
+                }
+                else {
+                    for (size_t child = index + 1; child < ends[index]; child = ends[child]) {
+                        group.run([&searchSubtree, child]() { searchSubtree(child); });
+                    }
+                }
+            }
+
+            if (!matches.empty()) {
+                std::lock_guard<std::mutex> lock(resultsMutex);
+                results[index] = std::move(matches);
+            }
+        };
+
+        searchSubtree(0);
+        group.wait();
+
+        std::vector<ExpressionMatch> result;
+        for (auto& [index, matches] : results) {
+            result.insert(result.end(), matches.begin(), matches.end());
+        }
+
+        return result;
+    }
+
     Expression* ExpressionMatcher::substitute(Expression* expr, Expression* pattern, Expression* substitution) {
         Expression* result = expr->copy();
         std::vector<ExpressionMatch> matches = ExpressionMatcher::matchAll(result, pattern);
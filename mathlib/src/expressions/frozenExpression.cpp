@@ -0,0 +1,90 @@
+#include "expressions/frozenExpression.hpp"
+
+#include "expressions/expressionHash.hpp"
+#include "expressions/expressions.hpp"
+#include "operators/differential.hpp"
+
+namespace cas::math {
+    FrozenExpression::FrozenExpression(Expression* expr) {
+        if (expr == nullptr)
+            return;
+
+        if (expr->parent != nullptr)
+            expr = expr->copy();
+
+        expression = std::shared_ptr<const Expression>(expr);
+        hash = hashExpression(expr);
+        nodes = countNodes(expr);
+    }
+
+    FrozenExpression FrozenExpression::copyOf(const Expression* expr) {
+        return FrozenExpression(expr == nullptr ? nullptr : expr->copy());
+    }
+
+    const Expression* FrozenExpression::get() const {
+        return expression.get();
+    }
+
+    const Expression* FrozenExpression::operator->() const {
+        return expression.get();
+    }
+
+    const Expression& FrozenExpression::operator*() const {
+        return *expression;
+    }
+
+    FrozenExpression::operator bool() const {
+        return expression != nullptr;
+    }
+
+    size_t FrozenExpression::getHash() const {
+        return hash;
+    }
+
+    size_t FrozenExpression::getNodeCount() const {
+        return nodes;
+    }
+
+    long FrozenExpression::getUseCount() const {
+        return expression.use_count();
+    }
+
+    Expression* FrozenExpression::thaw() const {
+        return expression == nullptr ? nullptr : expression->copy();
+    }
+
+    FrozenExpression FrozenExpression::simplify() const {
+        return FrozenExpression(expression->simplify());
+    }
+
+    FrozenExpression FrozenExpression::differentiate(const Variable& var) const {
+        return FrozenExpression(D(expression.get(), var));
+    }
+
+    FrozenExpression FrozenExpression::substitute(const Variable& var, const FrozenExpression& value) const {
+        Expression* result = thaw();
+
+        // setVariable only replaces variables below the root
+        if (result->getType() == ExpressionTypes::Variable) {
+            if (*static_cast<Variable*>(result) == var) {
+                delete result;
+                result = value.thaw();
+            }
+        }
+        else {
+            Variable symbol = var;
+            result->setVariable(&symbol, const_cast<Expression*>(value.get()));
+        }
+
+        return FrozenExpression(result);
+    }
+
+    bool FrozenExpression::operator==(const FrozenExpression& other) const {
+        if (expression == other.expression)
+            return true;
+        if (expression == nullptr || other.expression == nullptr)
+            return false;
+
+        return hash == other.hash && nodes == other.nodes && equalExpressions(expression.get(), other.expression.get());
+    }
+} // namespace cas::math
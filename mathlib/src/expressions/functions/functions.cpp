@@ -0,0 +1,31 @@
+#include "expressions/functions.hpp"
+
+#include <functional>
+#include <map>
+
+namespace cas::math {
+    BaseFunction* createFunction(const std::string& name, Expression* argument) {
+        using Factory = std::function<BaseFunction*(Expression*)>;
+
+        static const std::map<std::string, Factory> factories = {
+            {"sin", [](Expression* arg) { return new Sin(arg); }},
+            {"arcsin", [](Expression* arg) { return new Arcsin(arg); }},
+            {"cos", [](Expression* arg) { return new Cos(arg); }},
+            {"arccos", [](Expression* arg) { return new Arccos(arg); }},
+            {"tan", [](Expression* arg) { return new Tan(arg); }},
+            {"arctan", [](Expression* arg) { return new Arctan(arg); }},
+            {"sinh", [](Expression* arg) { return new Sinh(arg); }},
+            {"asinh", [](Expression* arg) { return new Asinh(arg); }},
+            {"cosh", [](Expression* arg) { return new Cosh(arg); }},
+            {"acosh", [](Expression* arg) { return new Acosh(arg); }},
+            {"ln", [](Expression* arg) { return new Ln(arg); }}};
+
+        auto it = factories.find(name);
+        if (it == factories.end()) {
+            delete argument;
+            throw std::runtime_error("Function " + name + " is not defined");
+        }
+
+        return it->second(argument);
+    }
+} // namespace cas::math
@@ -1,16 +1,20 @@
 #include "expressions/functions/hyperbolic.hpp"
 
 #include "expressions/operations.hpp"
+#include "expressions/resourceBudget.hpp"
+#include "parallel/cancellation.hpp"
 
 #include <cmath>
 
 namespace cas::math {
 #pragma region Sinh
-    Sinh::Sinh(const Expression& argument) {
+    Sinh::Sinh(const Expression& argument)
+        : Function("sinh") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Sinh::Sinh(Expression* argument) {
+    Sinh::Sinh(Expression* argument)
+        : Function("sinh") {
         arguments[0] = assign(argument, this);
     }
 
@@ -24,10 +28,13 @@ namespace cas::math {
     }
 
     Expression* Sinh::simplify() const {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         if (arguments[0]->getType() == ExpressionTypes::Function) {
             Function* argument = reinterpret_cast<Function*>(arguments[0]);
             if (argument->name == "asinh") {
-                return argument->arguments[0];
+                return argument->arguments[0]->copy();
             }
         }
 
@@ -40,11 +47,13 @@ namespace cas::math {
 #pragma endregion
 
 #pragma region Asinh
-    Asinh::Asinh(const Expression& argument) {
+    Asinh::Asinh(const Expression& argument)
+        : Function("asinh") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Asinh::Asinh(Expression* argument) {
+    Asinh::Asinh(Expression* argument)
+        : Function("asinh") {
         arguments[0] = assign(argument, this);
     }
 
@@ -58,10 +67,13 @@ namespace cas::math {
     }
 
     Expression* Asinh::simplify() const {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         if (arguments[0]->getType() == ExpressionTypes::Function) {
             Function* function = reinterpret_cast<Function*>(arguments[0]);
             if (function->name == "sinh") {
-                return function->arguments[0];
+                return function->arguments[0]->copy();
             }
         }
 
@@ -69,16 +81,18 @@ namespace cas::math {
     }
 
     Expression* Asinh::getDerivative() const {
-        return divide(1, sqrt(add(arguments[0], 2)));
+        return divide(1, sqrt(add(ExprRef::copyOf(arguments[0]), 2)));
     }
 #pragma endregion
 
 #pragma region Cosh
-    Cosh::Cosh(const Expression& argument) {
+    Cosh::Cosh(const Expression& argument)
+        : Function("cosh") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Cosh::Cosh(Expression* argument) {
+    Cosh::Cosh(Expression* argument)
+        : Function("cosh") {
         arguments[0] = assign(argument, this);
     }
 
@@ -92,10 +106,13 @@ namespace cas::math {
     }
 
     Expression* Cosh::simplify() const {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         if (arguments[0]->getType() == ExpressionTypes::Function) {
             Function* function = reinterpret_cast<Function*>(arguments[0]);
             if (function->name == "acosh") {
-                return function->arguments[0];
+                return function->arguments[0]->copy();
             }
         }
 
@@ -112,7 +129,8 @@ namespace cas::math {
         : Acosh(argument.copy()) {
     }
 
-    Acosh::Acosh(Expression* argument) {
+    Acosh::Acosh(Expression* argument)
+        : Function("acosh") {
         arguments[0] = assign(argument, this);
     }
 
@@ -126,10 +144,13 @@ namespace cas::math {
     }
 
     Expression* Acosh::simplify() const {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         if (arguments[0]->getType() == ExpressionTypes::Function) {
             Function* function = reinterpret_cast<Function*>(arguments[0]);
             if (function->name == "cosh") {
-                return function->arguments[0];
+                return function->arguments[0]->copy();
             }
         }
 
@@ -137,7 +158,7 @@ namespace cas::math {
     }
 
     Expression* Acosh::getDerivative() const {
-        return divide(1, sqrt(subtract(power(arguments[0], 2), 1)));
+        return divide(1, sqrt(subtract(power(ExprRef::copyOf(arguments[0]), 2), 1)));
     }
 #pragma endregion
 
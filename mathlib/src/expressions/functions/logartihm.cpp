@@ -2,6 +2,8 @@
 
 #include "expressions/operations.hpp"
 #include "expressions/terms/numeric/constants.hpp"
+#include "expressions/resourceBudget.hpp"
+#include "parallel/cancellation.hpp"
 #include <cmath>
 
 namespace cas::math {
@@ -11,7 +13,8 @@ namespace cas::math {
         : Ln(argument.copy()) {
     }
 
-    Ln::Ln(Expression* argument) {
+    Ln::Ln(Expression* argument)
+        : Function("ln") {
         arguments[0] = assign(argument, this);
     }
 
@@ -21,21 +24,26 @@ namespace cas::math {
     }
 
     Expression* Ln::copy() const {
-        return new Ln(arguments[0]->copy());
+        return new Ln(arguments[0]);
     }
 
     Expression* Ln::simplify() const {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         Expression* argument = this->arguments[0]->simplify();
 
         if (NamedConstant* c = dynamic_cast<NamedConstant*>(argument)) {
-            if (c->toString() == "e")
+            if (c->toString() == "e") {
+                delete argument;
                 return new Number(1);
+            }
         }
 
         return new Ln(argument);
     }
 
     Expression* Ln::getDerivative() const {
-        return divide(1, arguments[0]);
+        return divide(1, ExprRef::copyOf(arguments[0]));
     }
 } // namespace cas::math
\ No newline at end of file
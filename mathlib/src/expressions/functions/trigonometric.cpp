@@ -7,11 +7,13 @@
 namespace cas::math {
 
 #pragma region Sin
-    Sin::Sin(const Expression& argument) {
+    Sin::Sin(const Expression& argument)
+        : Function("sin") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Sin::Sin(Expression* argument) {
+    Sin::Sin(Expression* argument)
+        : Function("sin") {
         arguments[0] = assign(argument, this);
     }
 
@@ -30,11 +32,13 @@ namespace cas::math {
 #pragma endregion
 
 #pragma region Arcsin
-    Arcsin::Arcsin(const Expression& argument) {
+    Arcsin::Arcsin(const Expression& argument)
+        : Function("arcsin") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Arcsin::Arcsin(Expression* argument) {
+    Arcsin::Arcsin(Expression* argument)
+        : Function("arcsin") {
         arguments[0] = assign(argument, this);
     }
 
@@ -48,16 +52,18 @@ namespace cas::math {
     }
 
     Expression* Arcsin::getDerivative() const {
-        return divide(1, sqrt(subtract(1, power(arguments[0], 2))));
+        return divide(1, sqrt(subtract(1, power(ExprRef::copyOf(arguments[0]), 2))));
     }
 #pragma endregion
 
 #pragma region Cos
-    Cos::Cos(const Expression& argument) {
+    Cos::Cos(const Expression& argument)
+        : Function("cos") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Cos::Cos(Expression* argument) {
+    Cos::Cos(Expression* argument)
+        : Function("cos") {
         arguments[0] = assign(argument, this);
     }
 
@@ -77,11 +83,13 @@ namespace cas::math {
 #pragma endregion
 
 #pragma region Arccos
-    Arccos::Arccos(const Expression& argument) {
+    Arccos::Arccos(const Expression& argument)
+        : Function("arccos") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Arccos::Arccos(Expression* argument) {
+    Arccos::Arccos(Expression* argument)
+        : Function("arccos") {
         arguments[0] = assign(argument, this);
     }
 
@@ -96,16 +104,18 @@ namespace cas::math {
     }
 
     Expression* Arccos::getDerivative() const {
-        return divide(-1, sqrt(subtract(1, power(arguments[0], 2))));
+        return divide(-1, sqrt(subtract(1, power(ExprRef::copyOf(arguments[0]), 2))));
     }
 #pragma endregion
 
 #pragma region Tan
-    Tan::Tan(const Expression& argument) {
+    Tan::Tan(const Expression& argument)
+        : Function("tan") {
         arguments[0] = assign(argument.copy(), this);
     }
 
-    Tan::Tan(Expression* argument) {
+    Tan::Tan(Expression* argument)
+        : Function("tan") {
         arguments[0] = assign(argument, this);
     }
 
@@ -120,7 +130,7 @@ namespace cas::math {
     }
 
     Expression* Tan::getDerivative() const {
-        return add(1, power(new Tan(arguments[0]->copy()), 2));
+        return add(1, power(new Tan(arguments[0]), 2));
     }
 
 #pragma endregion
@@ -130,7 +140,8 @@ namespace cas::math {
         : Arctan(argument.copy()) {
     }
 
-    Arctan::Arctan(Expression* argument) {
+    Arctan::Arctan(Expression* argument)
+        : Function("arctan") {
         arguments[0] = assign(argument, this);
     }
 
@@ -145,7 +156,7 @@ namespace cas::math {
     }
 
     Expression* Arctan::getDerivative() const {
-        return divide(1, add(1, power(arguments[0], 2)));
+        return divide(1, add(1, power(ExprRef::copyOf(arguments[0]), 2)));
     }
 #pragma endregion
 } // namespace cas::math
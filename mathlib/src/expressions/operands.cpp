@@ -0,0 +1,86 @@
+#include "expressions/operands.hpp"
+
+#include "expressions/expressions.hpp"
+#include "parallel/threadPool.hpp"
+
+#include <algorithm>
+
+namespace cas::math {
+    std::vector<const Expression*> getOperands(const Expression* expr, ExpressionTypes type) {
+        std::vector<const Expression*> operands;
+
+        // sums and products are nested to the left, so the tree is walked without recursion
+        std::vector<const Expression*> stack = {expr};
+        while (!stack.empty()) {
+            const Expression* current = stack.back();
+            stack.pop_back();
+
+            if (current->getType() == type) {
+                const BinaryExpression* binary = static_cast<const BinaryExpression*>(current);
+                stack.push_back(binary->right);
+                stack.push_back(binary->left);
+            }
+            else {
+                operands.push_back(current);
+            }
+        }
+
+        return operands;
+    }
+
+    namespace {
+        // the number of nodes of the operands. The count stops at the limit, so only a bounded part of large operands is
+        // visited
+        size_t countNodes(const std::vector<const Expression*>& operands, size_t limit) {
+            size_t count = 0;
+
+            std::vector<const Expression*> stack(operands.begin(), operands.end());
+            while (!stack.empty() && count < limit) {
+                const Expression* current = stack.back();
+                stack.pop_back();
+                count++;
+
+                for (const Expression* child : current->getChildren()) {
+                    stack.push_back(child);
+                }
+            }
+
+            return count;
+        }
+    } // namespace
+
+    std::vector<Expression*> simplifyOperands(const std::vector<const Expression*>& operands) {
+        std::vector<Expression*> result(operands.size(), nullptr);
+
+        auto simplifyRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                result[i] = operands[i]->simplify();
+            }
+        };
+
+        try {
+            if (operands.size() < 2 || countNodes(operands, parallelSimplifyThreshold) < parallelSimplifyThreshold) {
+                simplifyRange(0, operands.size());
+            }
+            else {
+                // a few chunks per thread, so threads that finish early can take the chunks of others
+                ThreadPool& pool = ThreadPool::shared();
+                const size_t grainSize = std::max<size_t>(operands.size() / (4 * pool.getThreadCount()), 1);
+
+                pool.parallelFor(0, operands.size(), simplifyRange, grainSize);
+            }
+        }
+        catch (...) {
+            for (Expression* operand : result) {
+                delete operand;
+            }
+            throw;
+        }
+
+        return result;
+    }
+
+    bool isRealNumber(const Expression* expr) {
+        return expr->getType() == ExpressionTypes::Constant && dynamic_cast<const Complex*>(expr) == nullptr;
+    }
+} // namespace cas::math
@@ -0,0 +1,96 @@
+#include "expressions/resourceBudget.hpp"
+
+namespace cas::math {
+    thread_local ResourceBudget* ResourceBudget::current = nullptr;
+    thread_local size_t ResourceBudget::depth = 0;
+    std::atomic<size_t> ResourceBudget::nextId = 1;
+
+    resource_limit_error::resource_limit_error(const std::string& message)
+        : std::runtime_error(message) {
+    }
+
+#pragma region ResourceBudget
+    ResourceBudget::ResourceBudget(const ResourceLimits& limits)
+        : limits(limits), id(nextId.fetch_add(1, std::memory_order_relaxed)) {
+    }
+
+    const ResourceLimits& ResourceBudget::getLimits() const {
+        return limits;
+    }
+
+    long long ResourceBudget::getNodes() const {
+        return nodes.load(std::memory_order_relaxed);
+    }
+
+    long long ResourceBudget::getBytes() const {
+        return bytes.load(std::memory_order_relaxed);
+    }
+
+    size_t ResourceBudget::allocate(size_t size) {
+        ResourceBudget* budget = current;
+        if (budget == nullptr)
+            return 0;
+
+        const long long nodeCount = budget->nodes.fetch_add(1, std::memory_order_relaxed) + 1;
+        const long long byteCount = budget->bytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+        const ResourceLimits& limits = budget->limits;
+        if ((limits.maxNodes != 0 && nodeCount > static_cast<long long>(limits.maxNodes)) ||
+            (limits.maxBytes != 0 && byteCount > static_cast<long long>(limits.maxBytes))) {
+            // the node is not allocated
+            budget->nodes.fetch_sub(1, std::memory_order_relaxed);
+            budget->bytes.fetch_sub(size, std::memory_order_relaxed);
+
+            if (limits.maxNodes != 0 && nodeCount > static_cast<long long>(limits.maxNodes))
+                throw resource_limit_error("The command exceeded the limit of " + std::to_string(limits.maxNodes) + " expression nodes");
+
+            throw resource_limit_error("The command exceeded the limit of " + std::to_string(limits.maxBytes) + " bytes");
+        }
+
+        return budget->id;
+    }
+
+    void ResourceBudget::release(size_t size, size_t owner) {
+        // nodes allocated before the scope, e.g. cached results or the old ans, were never charged to this budget
+        ResourceBudget* budget = current;
+        if (budget == nullptr || budget->id != owner)
+            return;
+
+        budget->nodes.fetch_sub(1, std::memory_order_relaxed);
+        budget->bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    ResourceBudget* ResourceBudget::getCurrent() {
+        return current;
+    }
+#pragma endregion
+
+#pragma region BudgetScope
+    BudgetScope::BudgetScope(ResourceBudget* budget)
+        : previous(ResourceBudget::current), previousDepth(ResourceBudget::depth) {
+        ResourceBudget::current = budget;
+        ResourceBudget::depth = 0;
+    }
+
+    BudgetScope::~BudgetScope() {
+        ResourceBudget::current = previous;
+        ResourceBudget::depth = previousDepth;
+    }
+#pragma endregion
+
+#pragma region DepthGuard
+    DepthGuard::DepthGuard() {
+        const size_t depth = ++ResourceBudget::depth;
+
+        const ResourceBudget* budget = ResourceBudget::current;
+        if (budget != nullptr && budget->limits.maxDepth != 0 && depth > budget->limits.maxDepth) {
+            ResourceBudget::depth--;
+            throw resource_limit_error("The command exceeded the recursion depth of " + std::to_string(budget->limits.maxDepth));
+        }
+    }
+
+    DepthGuard::~DepthGuard() {
+        ResourceBudget::depth--;
+    }
+#pragma endregion
+} // namespace cas::math
@@ -1,10 +1,36 @@
 #include "expressions/expressions.hpp"
 
+#include "expressions/expressionHash.hpp"
+#include "expressions/operands.hpp"
+#include "expressions/resourceBudget.hpp"
 #include "expressions/simplifier.hpp"
+#include "parallel/cancellation.hpp"
 
+#include <memory>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace cas::math {
+    namespace {
+        // term = coefficient * rest. The rest of a constant term is nullptr
+        struct Term {
+            double coefficient;
+            const Expression* rest;
+        };
+
+        Term splitTerm(const Expression* term) {
+            if (isRealNumber(term))
+                return {static_cast<const Number*>(term)->realValue, nullptr};
+
+            if (term->getType() == ExpressionTypes::Multiplication) {
+                const Multiplication* product = static_cast<const Multiplication*>(term);
+                if (isRealNumber(product->left))
+                    return {static_cast<const Number*>(product->left)->realValue, product->right};
+            }
+
+            return {1, term};
+        }
+    } // namespace
 
     Addition::Addition(const Expression& left, const Expression& right)
         : BinaryExpression(left, right) {
@@ -19,7 +45,12 @@ namespace cas::math {
     }
 
     Expression* Addition::copy() const {
-        return new Addition(left->copy(), right->copy());
+        DepthGuard depthGuard;
+
+        std::unique_ptr<Expression> leftCopy(left->copy());
+        std::unique_ptr<Expression> rightCopy(right->copy());
+
+        return makeNode<Addition>(leftCopy, rightCopy);
     }
 
     ExpressionTypes Addition::getType() const {
@@ -27,12 +58,75 @@ namespace cas::math {
     }
 
     Expression* Addition::simplify() const {
-        //return Simplifier::simplifyAddition(this);
-        return copy();
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        // the summands are simplified independently, large sums in parallel
+        std::vector<Expression*> simplified = simplifyOperands(getOperands(this, ExpressionTypes::Addition));
+
+        // simplified summands can be sums again
+        std::vector<const Expression*> terms;
+        for (const Expression* summand : simplified) {
+            for (const Expression* term : getOperands(summand, ExpressionTypes::Addition)) {
+                terms.push_back(term);
+            }
+        }
+
+        // like terms are combined at the position of their first occurrence
+        std::vector<Term> groups;
+        std::unordered_multimap<size_t, size_t> groupsByHash;
+        constexpr size_t constantHash = 0;
+        for (const Expression* term : terms) {
+            const Term parts = splitTerm(term);
+            const size_t hash = parts.rest == nullptr ? constantHash : hashExpression(parts.rest);
+
+            bool found = false;
+            auto [begin, end] = groupsByHash.equal_range(hash);
+            for (auto it = begin; it != end && !found; it++) {
+                Term& group = groups[it->second];
+                if (group.rest == parts.rest || (group.rest != nullptr && parts.rest != nullptr && equalExpressions(group.rest, parts.rest))) {
+                    group.coefficient += parts.coefficient;
+                    found = true;
+                }
+            }
+
+            if (!found) {
+                groupsByHash.emplace(hash, groups.size());
+                groups.push_back({parts.coefficient, parts.rest});
+            }
+        }
+
+        Expression* result = nullptr;
+        for (const Term& group : groups) {
+            if (group.coefficient == 0)
+                continue;
+
+            Expression* term;
+            if (group.rest == nullptr)
+                term = new Number(group.coefficient);
+            else if (group.coefficient == 1)
+                term = group.rest->copy();
+            else
+                term = new Multiplication(new Number(group.coefficient), group.rest->copy());
+
+            result = result == nullptr ? term : new Addition(result, term);
+        }
+
+        for (Expression* summand : simplified) {
+            delete summand;
+        }
+
+        return result == nullptr ? new Number(0) : result;
     }
 
     Expression* Addition::differentiate(const Variable* var) const {
-        return new Addition(left->differentiate(var), right->differentiate(var));
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        std::unique_ptr<Expression> dLeft(left->differentiate(var));
+        std::unique_ptr<Expression> dRight(right->differentiate(var));
+
+        return makeNode<Addition>(dLeft, dRight);
     }
 
     std::string Addition::toString() const {
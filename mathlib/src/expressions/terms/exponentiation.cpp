@@ -1,8 +1,13 @@
 #include "expressions/expressions.hpp"
 
+#include "expressions/operands.hpp"
+#include "expressions/resourceBudget.hpp"
 #include "expressions/simplifier.hpp"
+#include "parallel/cancellation.hpp"
 
+#include <cmath>
 #include <math.h>
+#include <memory>
 #include <sstream>
 
 namespace cas::math {
@@ -19,7 +24,12 @@ namespace cas::math {
     }
 
     Expression* Exponentiation::copy() const {
-        return new Exponentiation(left->copy(), right->copy());
+        DepthGuard depthGuard;
+
+        std::unique_ptr<Expression> leftCopy(left->copy());
+        std::unique_ptr<Expression> rightCopy(right->copy());
+
+        return makeNode<Exponentiation>(leftCopy, rightCopy);
     }
 
     ExpressionTypes Exponentiation::getType() const {
@@ -27,21 +37,62 @@ namespace cas::math {
     }
 
     Expression* Exponentiation::simplify() const {
-        //return Simplifier::simplifyExponentiation(this);
-        return copy();
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        Expression* base = left->simplify();
+        Expression* exponent = right->simplify();
+
+        if (isRealNumber(exponent)) {
+            const double exponentValue = static_cast<const Number*>(exponent)->realValue;
+
+            if (exponentValue == 0 || exponentValue == 1) {
+                delete exponent;
+                if (exponentValue == 1)
+                    return base;
+
+                delete base;
+                return new Number(1);
+            }
+
+            // powers of real numbers are only evaluated if the result is real
+            if (isRealNumber(base)) {
+                const double baseValue = static_cast<const Number*>(base)->realValue;
+                if (baseValue >= 0 || std::floor(exponentValue) == exponentValue) {
+                    const double value = std::pow(baseValue, exponentValue);
+                    if (std::isfinite(value)) {
+                        delete base;
+                        delete exponent;
+                        return new Number(value);
+                    }
+                }
+            }
+        }
+
+        return new Exponentiation(base, exponent);
     }
 
     Expression* Exponentiation::differentiate(const Variable* var) const {
-        Expression* dBase = left->differentiate(var);
-        Expression* dExp = right->differentiate(var);
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        std::unique_ptr<Expression> dBase(left->differentiate(var));
+        std::unique_ptr<Expression> dExp(right->differentiate(var));
 
         // d(a^b)=d(e^(b*ln(a)))=e^(b*ln(a))*d(b*ln(a))=a^b*(db*ln(a)+b*da/a)
-        return new Multiplication(this->copy(),
-            new Addition(new Multiplication(dExp, new Ln(left)),
-                new Multiplication(right,
-                    new Multiplication(dBase,
-                        new Exponentiation(left,
-                            new Number(-1))))));
+        std::unique_ptr<Expression> power(this->copy());
+        std::unique_ptr<Expression> lnBase(new Ln(left));
+        std::unique_ptr<Expression> baseCopy(left->copy());
+        std::unique_ptr<Expression> minusOne(new Number(-1));
+        std::unique_ptr<Expression> exponentCopy(right->copy());
+
+        std::unique_ptr<Expression> exponentTerm(makeNode<Multiplication>(dExp, lnBase));
+        std::unique_ptr<Expression> inverseBase(makeNode<Exponentiation>(baseCopy, minusOne));
+        std::unique_ptr<Expression> quotient(makeNode<Multiplication>(dBase, inverseBase));
+        std::unique_ptr<Expression> baseTerm(makeNode<Multiplication>(exponentCopy, quotient));
+        std::unique_ptr<Expression> sum(makeNode<Addition>(exponentTerm, baseTerm));
+
+        return makeNode<Multiplication>(power, sum);
     }
 
     std::string Exponentiation::toString() const {
@@ -1,6 +1,9 @@
 #include "expressions/terms/expression.hpp"
 
 #include "expressions/expressions.hpp"
+#include "expressions/resourceBudget.hpp"
+
+#include <cstddef>
 
 #if DEBUG
 #include "debug/debugTools.hpp"
@@ -16,12 +19,13 @@ namespace cas::math {
     }
 
 #if DEBUG
-    unsigned int Expression::expressionCounter = 0;
+    std::atomic<unsigned int> Expression::expressionCounter = 0;
 
     Expression::Expression() {
-        expressionCounter++;
+        const unsigned int count = ++expressionCounter;
 
-        memLog << "created expression " << (void*)this << " total:" << expressionCounter << " "
+        std::lock_guard<std::mutex> lock(memLogMutex);
+        memLog << "created expression " << (void*)this << " total:" << count << " "
 #if WIN32
                << _ReturnAddress()
 #else
@@ -31,10 +35,43 @@ namespace cas::math {
     }
 #endif
 
+    namespace {
+        // the id of the owning budget is stored in front of every node. The header keeps the alignment of the node
+        constexpr std::size_t ownerHeaderSize = alignof(std::max_align_t);
+        static_assert(ownerHeaderSize >= sizeof(std::size_t));
+    } // namespace
+
+    void* Expression::operator new(std::size_t size) {
+        const std::size_t owner = ResourceBudget::allocate(size);
+
+        void* block;
+        try {
+            block = ::operator new(size + ownerHeaderSize);
+        }
+        catch (...) {
+            ResourceBudget::release(size, owner);
+            throw;
+        }
+
+        *static_cast<std::size_t*>(block) = owner;
+        return static_cast<char*>(block) + ownerHeaderSize;
+    }
+
+    void Expression::operator delete(void* ptr, std::size_t size) {
+        if (ptr == nullptr)
+            return;
+
+        void* block = static_cast<char*>(ptr) - ownerHeaderSize;
+        ResourceBudget::release(size, *static_cast<std::size_t*>(block));
+        ::operator delete(block);
+    }
+
     Expression::~Expression() {
 #if DEBUG
-        expressionCounter--;
-        memLog << "deleted expression " << (void*)this << " total:" << expressionCounter << " "
+        const unsigned int count = --expressionCounter;
+
+        std::lock_guard<std::mutex> lock(memLogMutex);
+        memLog << "deleted expression " << (void*)this << " total:" << count << " "
 #if WIN32
                << _ReturnAddress()
 #else
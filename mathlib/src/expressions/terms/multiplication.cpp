@@ -1,8 +1,32 @@
 #include "expressions/expressions.hpp"
 
+#include "expressions/expressionHash.hpp"
+#include "expressions/operands.hpp"
+#include "expressions/resourceBudget.hpp"
 #include "expressions/simplifier.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <memory>
+#include <unordered_map>
 
 namespace cas::math {
+    namespace {
+        // factor = base ^ exponent
+        struct Factor {
+            const Expression* base;
+            double exponent;
+        };
+
+        Factor splitFactor(const Expression* factor) {
+            if (factor->getType() == ExpressionTypes::Exponentiation) {
+                const Exponentiation* power = static_cast<const Exponentiation*>(factor);
+                if (isRealNumber(power->right))
+                    return {power->left, static_cast<const Number*>(power->right)->realValue};
+            }
+
+            return {factor, 1};
+        }
+    } // namespace
     Multiplication::Multiplication(const Expression& left, const Expression& right)
         : BinaryExpression(left, right) {
     }
@@ -16,7 +40,12 @@ namespace cas::math {
     }
 
     Expression* Multiplication::copy() const {
-        return new Multiplication(left->copy(), right->copy());
+        DepthGuard depthGuard;
+
+        std::unique_ptr<Expression> leftCopy(left->copy());
+        std::unique_ptr<Expression> rightCopy(right->copy());
+
+        return makeNode<Multiplication>(leftCopy, rightCopy);
     }
 
     ExpressionTypes Multiplication::getType() const {
@@ -24,22 +53,85 @@ namespace cas::math {
     }
 
     Expression* Multiplication::simplify() const {
-        //return Simplifier::simplifyMultiplication(this);
-        return copy();
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        // the factors are simplified independently, large products in parallel
+        std::vector<Expression*> simplified = simplifyOperands(getOperands(this, ExpressionTypes::Multiplication));
+
+        // numbers are multiplied into the coefficient, powers of the same base are combined at the position of the
+        // first occurrence
+        double coefficient = 1;
+        std::vector<Factor> groups;
+        std::unordered_multimap<size_t, size_t> groupsByHash;
+        for (const Expression* operand : simplified) {
+            for (const Expression* factor : getOperands(operand, ExpressionTypes::Multiplication)) {
+                if (isRealNumber(factor)) {
+                    coefficient *= static_cast<const Number*>(factor)->realValue;
+                    continue;
+                }
+
+                const Factor parts = splitFactor(factor);
+                const size_t hash = hashExpression(parts.base);
+
+                bool found = false;
+                auto [begin, end] = groupsByHash.equal_range(hash);
+                for (auto it = begin; it != end && !found; it++) {
+                    Factor& group = groups[it->second];
+                    if (equalExpressions(group.base, parts.base)) {
+                        group.exponent += parts.exponent;
+                        found = true;
+                    }
+                }
+
+                if (!found) {
+                    groupsByHash.emplace(hash, groups.size());
+                    groups.push_back(parts);
+                }
+            }
+        }
+
+        Expression* result = nullptr;
+        if (coefficient == 0) {
+            result = new Number(0);
+        }
+        else {
+            for (const Factor& group : groups) {
+                if (group.exponent == 0)
+                    continue;
+
+                Expression* factor = group.exponent == 1 ? group.base->copy() : new Exponentiation(group.base->copy(), new Number(group.exponent));
+                result = result == nullptr ? factor : new Multiplication(result, factor);
+            }
+
+            if (result == nullptr)
+                result = new Number(coefficient);
+            else if (coefficient != 1)
+                result = new Multiplication(new Number(coefficient), result);
+        }
+
+        for (Expression* operand : simplified) {
+            delete operand;
+        }
+
+        return result;
     }
 
     Expression* Multiplication::differentiate(const Variable* var) const {
+        checkCancellation();
+        DepthGuard depthGuard;
+
         // calculate the derivative of the two factors
-        Expression* dLeft = left->differentiate(var);
-        Expression* dRight = right->differentiate(var);
+        std::unique_ptr<Expression> dLeft(left->differentiate(var));
+        std::unique_ptr<Expression> dRight(right->differentiate(var));
+        std::unique_ptr<Expression> leftCopy(left->copy());
+        std::unique_ptr<Expression> rightCopy(right->copy());
 
         // apply product rule
-        Expression* rLeft = new Multiplication(dLeft, right);
-        Expression* rRight = new Multiplication(left, dRight);
-
-        Expression* result = new Addition(rLeft, rRight);
+        std::unique_ptr<Expression> rLeft(makeNode<Multiplication>(dLeft, rightCopy));
+        std::unique_ptr<Expression> rRight(makeNode<Multiplication>(leftCopy, dRight));
 
-        return result;
+        return makeNode<Addition>(rLeft, rRight);
     }
 
     std::string Multiplication::toString() const {
@@ -2,6 +2,8 @@
 
 #include "expressions/terms/variable.hpp"
 
+#include <charconv>
+
 #if WIN32
 #include <numbers>
 #endif
@@ -33,19 +35,12 @@ namespace cas::math {
     }
 
     std::string Number::toString() const {
-        std::string str = std::to_string(realValue);
-
-        // remove leading zeros
-        if (str.find('.') != std::string::npos) {
-            while (str.back() == '0') {
-                str.pop_back();
-            }
-        }
-        if (str.back() == '.') {
-            str.pop_back();
-        }
-
-        return str;
+        // shortest representation that reads back to the same value. The parser knows no exponents, so the number is
+        // written without one. The largest and the smallest doubles have about 330 digits
+        char buffer[512];
+        const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), realValue, std::chars_format::fixed);
+
+        return std::string(buffer, end);
     }
 
     std::set<Variable> Number::getVariables() const {
@@ -28,7 +28,7 @@ namespace cas::math {
         return new Complex(realValue, imaginary);
     }
 
-    Number Complex::conjugate() const {
+    Complex Complex::conjugate() const {
         return Complex(realValue, -imaginary);
     }
 
@@ -73,9 +73,10 @@ namespace cas::math {
     }
 
     Complex Complex::operator/(const Complex& other) const {
-        Number denominator = other.realValue * other.realValue + other.imaginary * other.imaginary;
+        double denominator = other.realValue * other.realValue + other.imaginary * other.imaginary;
+        Complex numerator = *this * other.conjugate();
 
-        return *this * other.conjugate() / denominator;
+        return Complex(numerator.realValue / denominator, numerator.imaginary / denominator);
     }
 
     Complex exp(const Complex& c) {
@@ -23,7 +23,7 @@ namespace cas::math {
     }
 
     Expression* Variable::copy() const {
-        return new Variable(*this);
+        return new Variable(symbol);
     }
 
     ExpressionTypes Variable::getType() const {
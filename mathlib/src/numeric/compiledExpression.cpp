@@ -0,0 +1,286 @@
+#include "numeric/compiledExpression.hpp"
+
+#include "expressions/expressions.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace cas::math {
+    namespace {
+        constexpr int maxIntegerPower = 64;
+        constexpr size_t fixedStackSize = 64;
+        constexpr size_t batchSize = 32;
+        constexpr size_t fixedBatchStackSize = 16;
+
+        const std::map<std::string, CompiledExpression::OpCode> functionOpCodes = {
+            {"sin", CompiledExpression::OpCode::Sin},
+            {"arcsin", CompiledExpression::OpCode::Arcsin},
+            {"cos", CompiledExpression::OpCode::Cos},
+            {"arccos", CompiledExpression::OpCode::Arccos},
+            {"tan", CompiledExpression::OpCode::Tan},
+            {"arctan", CompiledExpression::OpCode::Arctan},
+            {"sinh", CompiledExpression::OpCode::Sinh},
+            {"asinh", CompiledExpression::OpCode::Asinh},
+            {"cosh", CompiledExpression::OpCode::Cosh},
+            {"acosh", CompiledExpression::OpCode::Acosh},
+            {"ln", CompiledExpression::OpCode::Ln}};
+
+        inline double integerPower(double base, int exponent) {
+            unsigned int n = static_cast<unsigned int>(std::abs(exponent));
+            double result = 1;
+
+            while (n > 0) {
+                if (n & 1)
+                    result *= base;
+
+                base *= base;
+                n >>= 1;
+            }
+
+            return exponent < 0 ? 1 / result : result;
+        }
+
+        double run(const CompiledExpression::Instruction* begin, const CompiledExpression::Instruction* end, const double* values, double* stack) {
+            using OpCode = CompiledExpression::OpCode;
+            double* top = stack - 1;
+
+            for (const CompiledExpression::Instruction* it = begin; it != end; it++) {
+                switch (it->opCode) {
+                    case OpCode::Constant: *(++top) = it->value; break;
+                    case OpCode::Variable: *(++top) = values[it->index]; break;
+                    case OpCode::Add:
+                        top--;
+                        *top += top[1];
+                        break;
+                    case OpCode::Multiply:
+                        top--;
+                        *top *= top[1];
+                        break;
+                    case OpCode::Power:
+                        top--;
+                        *top = std::pow(*top, top[1]);
+                        break;
+                    case OpCode::IntegerPower: *top = integerPower(*top, it->index); break;
+                    case OpCode::Sin: *top = std::sin(*top); break;
+                    case OpCode::Arcsin: *top = std::asin(*top); break;
+                    case OpCode::Cos: *top = std::cos(*top); break;
+                    case OpCode::Arccos: *top = std::acos(*top); break;
+                    case OpCode::Tan: *top = std::tan(*top); break;
+                    case OpCode::Arctan: *top = std::atan(*top); break;
+                    case OpCode::Sinh: *top = std::sinh(*top); break;
+                    case OpCode::Asinh: *top = std::asinh(*top); break;
+                    case OpCode::Cosh: *top = std::cosh(*top); break;
+                    case OpCode::Acosh: *top = std::acosh(*top); break;
+                    case OpCode::Ln: *top = std::log(*top); break;
+                }
+            }
+
+            return *top;
+        }
+
+        // same as run, but every stack entry holds batchSize values
+        void runBatch(const CompiledExpression::Instruction* begin, const CompiledExpression::Instruction* end, const double* values, size_t variableCount,
+                      size_t count, double* stack, double* results) {
+            using OpCode = CompiledExpression::OpCode;
+            double* top = stack - batchSize;
+
+            auto unary = [&](auto func) {
+                for (size_t i = 0; i < count; i++) {
+                    top[i] = func(top[i]);
+                }
+            };
+
+            for (const CompiledExpression::Instruction* it = begin; it != end; it++) {
+                switch (it->opCode) {
+                    case OpCode::Constant:
+                        top += batchSize;
+                        std::fill(top, top + count, it->value);
+                        break;
+                    case OpCode::Variable:
+                        top += batchSize;
+                        for (size_t i = 0; i < count; i++) {
+                            top[i] = values[i * variableCount + it->index];
+                        }
+                        break;
+                    case OpCode::Add:
+                        top -= batchSize;
+                        for (size_t i = 0; i < count; i++) {
+                            top[i] += top[i + batchSize];
+                        }
+                        break;
+                    case OpCode::Multiply:
+                        top -= batchSize;
+                        for (size_t i = 0; i < count; i++) {
+                            top[i] *= top[i + batchSize];
+                        }
+                        break;
+                    case OpCode::Power:
+                        top -= batchSize;
+                        for (size_t i = 0; i < count; i++) {
+                            top[i] = std::pow(top[i], top[i + batchSize]);
+                        }
+                        break;
+                    case OpCode::IntegerPower: unary([exponent = it->index](double x) { return integerPower(x, exponent); }); break;
+                    case OpCode::Sin: unary([](double x) { return std::sin(x); }); break;
+                    case OpCode::Arcsin: unary([](double x) { return std::asin(x); }); break;
+                    case OpCode::Cos: unary([](double x) { return std::cos(x); }); break;
+                    case OpCode::Arccos: unary([](double x) { return std::acos(x); }); break;
+                    case OpCode::Tan: unary([](double x) { return std::tan(x); }); break;
+                    case OpCode::Arctan: unary([](double x) { return std::atan(x); }); break;
+                    case OpCode::Sinh: unary([](double x) { return std::sinh(x); }); break;
+                    case OpCode::Asinh: unary([](double x) { return std::asinh(x); }); break;
+                    case OpCode::Cosh: unary([](double x) { return std::cosh(x); }); break;
+                    case OpCode::Acosh: unary([](double x) { return std::acosh(x); }); break;
+                    case OpCode::Ln: unary([](double x) { return std::log(x); }); break;
+                }
+            }
+
+            std::copy(top, top + count, results);
+        }
+    } // namespace
+
+    CompiledExpression::CompiledExpression(const Expression* expr, const std::vector<Variable>& variables)
+        : variableCount(variables.size()) {
+        stackSize = compile(expr, variables);
+    }
+
+    size_t CompiledExpression::compile(const Expression* expr, const std::vector<Variable>& variables) {
+        const size_t start = instructions.size();
+        const size_t variablesBefore = variableReferences;
+        size_t depth;
+
+        switch (expr->getType()) {
+            case ExpressionTypes::Constant:
+            case ExpressionTypes::NamedConstant: {
+                const Complex* complex = dynamic_cast<const Complex*>(expr);
+                if (complex != nullptr && complex->imaginary != 0)
+                    throw std::runtime_error("Cannot compile the complex number " + expr->toString());
+
+                instructions.push_back({OpCode::Constant, 0, static_cast<const Number*>(expr)->realValue});
+                return 1;
+            }
+            case ExpressionTypes::Variable: {
+                const Variable* var = static_cast<const Variable*>(expr);
+                for (size_t i = 0; i < variables.size(); i++) {
+                    if (variables[i] == *var) {
+                        instructions.push_back({OpCode::Variable, static_cast<int>(i)});
+                        variableReferences++;
+                        return 1;
+                    }
+                }
+
+                throw std::runtime_error("Cannot compile the unknown variable " + var->getSymbol());
+            }
+            case ExpressionTypes::Addition:
+            case ExpressionTypes::Multiplication: {
+                const BinaryExpression* binary = static_cast<const BinaryExpression*>(expr);
+                const bool addition = expr->getType() == ExpressionTypes::Addition;
+
+                const size_t leftDepth = compile(binary->left, variables);
+                const size_t middle = instructions.size();
+                const size_t rightDepth = compile(binary->right, variables);
+
+                auto isConstant = [this](size_t index, double value) {
+                    return instructions[index].opCode == OpCode::Constant && instructions[index].value == value;
+                };
+                const bool leftConstant = middle == start + 1 && instructions[start].opCode == OpCode::Constant;
+                const bool rightConstant = middle + 1 == instructions.size() && instructions[middle].opCode == OpCode::Constant;
+
+                // derivatives contain a lot of factors 0 and 1 and summands 0
+                if (!addition && ((leftConstant && isConstant(start, 0)) || (rightConstant && isConstant(middle, 0)))) {
+                    instructions.resize(start);
+                    instructions.push_back({OpCode::Constant, 0, 0});
+                    variableReferences = variablesBefore;
+                    return 1;
+                }
+
+                const double neutral = addition ? 0 : 1;
+                if (rightConstant && isConstant(middle, neutral)) {
+                    instructions.pop_back();
+                    return leftDepth;
+                }
+                if (leftConstant && isConstant(start, neutral)) {
+                    instructions.erase(instructions.begin() + start);
+                    return rightDepth;
+                }
+
+                depth = std::max(leftDepth, rightDepth + 1);
+                instructions.push_back({addition ? OpCode::Add : OpCode::Multiply});
+            } break;
+            case ExpressionTypes::Exponentiation: {
+                const Exponentiation* exp = static_cast<const Exponentiation*>(expr);
+                const size_t baseDepth = compile(exp->left, variables);
+
+                if (exp->right->getType() == ExpressionTypes::Constant) {
+                    const double exponent = exp->right->getValue().realValue;
+                    if (std::floor(exponent) == exponent && std::abs(exponent) <= maxIntegerPower) {
+                        depth = baseDepth;
+                        instructions.push_back({OpCode::IntegerPower, static_cast<int>(exponent)});
+                        break;
+                    }
+                }
+
+                const size_t exponentDepth = compile(exp->right, variables);
+                depth = std::max(baseDepth, exponentDepth + 1);
+                instructions.push_back({OpCode::Power});
+            } break;
+            case ExpressionTypes::Function: {
+                const BaseFunction* function = static_cast<const BaseFunction*>(expr);
+                auto it = functionOpCodes.find(function->name);
+                if (it == functionOpCodes.end())
+                    throw std::runtime_error("Cannot compile the function " + function->name);
+
+                depth = compile(expr->getChildren().front(), variables);
+                instructions.push_back({it->second});
+            } break;
+            default:
+                throw std::runtime_error("Cannot compile " + expr->toString());
+        }
+
+        // fold subexpressions without variables into a single constant
+        if (variableReferences != variablesBefore)
+            return depth;
+
+        std::vector<double> stack(depth);
+        const double value = run(instructions.data() + start, instructions.data() + instructions.size(), nullptr, stack.data());
+
+        instructions.resize(start);
+        instructions.push_back({OpCode::Constant, 0, value});
+        return 1;
+    }
+
+    const std::vector<CompiledExpression::Instruction>& CompiledExpression::getInstructions() const {
+        return instructions;
+    }
+
+    double CompiledExpression::evaluate(const double* values) const {
+        if (stackSize <= fixedStackSize) {
+            double stack[fixedStackSize];
+            return run(instructions.data(), instructions.data() + instructions.size(), values, stack);
+        }
+
+        std::vector<double> stack(stackSize);
+        return run(instructions.data(), instructions.data() + instructions.size(), values, stack.data());
+    }
+
+    void CompiledExpression::evaluate(const double* values, size_t count, double* results) const {
+        double fixedStack[fixedBatchStackSize * batchSize];
+        std::vector<double> dynamicStack;
+
+        double* stack = fixedStack;
+        if (stackSize > fixedBatchStackSize) {
+            dynamicStack.resize(stackSize * batchSize);
+            stack = dynamicStack.data();
+        }
+
+        for (size_t offset = 0; offset < count; offset += batchSize) {
+            checkCancellation();
+
+            const size_t blockCount = std::min(batchSize, count - offset);
+            runBatch(instructions.data(), instructions.data() + instructions.size(), values + offset * variableCount, variableCount, blockCount, stack,
+                     results + offset);
+        }
+    }
+} // namespace cas::math
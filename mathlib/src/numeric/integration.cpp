@@ -0,0 +1,178 @@
+#include "numeric/integration.hpp"
+
+#include "parallel/cancellation.hpp"
+#include "parallel/threadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cas::math {
+    namespace {
+        constexpr size_t kronrodPoints = 15;
+        constexpr size_t intervalsPerRound = 16;
+
+        // nodes and weights of the 15 point Kronrod rule and the embedded 7 point Gauss rule (QUADPACK qk15)
+        constexpr double kronrodNodes[8] = {
+            0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926,
+            0.741531185599394439863864773280788, 0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+            0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+
+        constexpr double kronrodWeights[8] = {
+            0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518,
+            0.140653259715525918745189590510238, 0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+            0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+
+        constexpr double gaussWeights[4] = {
+            0.129484966168869693270611432679082, 0.279705391489276667901467771423780, 0.381830050505118944950369775488975,
+            0.417959183673469387755102040816327};
+
+        struct Interval {
+            double a, b;
+            double value;
+            double error;
+
+            inline bool operator<(const Interval& other) const {
+                return error < other.error;
+            }
+        };
+
+        Interval evaluateInterval(const CompiledExpression& integrand, double a, double b) {
+            const double center = (a + b) / 2;
+            const double halfLength = (b - a) / 2;
+
+            // point 7 is the center, the points 2 * i and 2 * i + 1 are symmetric around it
+            double points[kronrodPoints];
+            double values[kronrodPoints];
+            for (size_t i = 0; i < 7; i++) {
+                points[2 * i] = center - halfLength * kronrodNodes[i];
+                points[2 * i + 1] = center + halfLength * kronrodNodes[i];
+            }
+            points[14] = center;
+
+            integrand.evaluate(points, kronrodPoints, values);
+
+            double kronrod = kronrodWeights[7] * values[14];
+            double gauss = gaussWeights[3] * values[14];
+            double absolute = kronrodWeights[7] * std::abs(values[14]);
+
+            for (size_t i = 0; i < 7; i++) {
+                const double sum = values[2 * i] + values[2 * i + 1];
+                kronrod += kronrodWeights[i] * sum;
+                absolute += kronrodWeights[i] * (std::abs(values[2 * i]) + std::abs(values[2 * i + 1]));
+
+                if (i % 2 == 1)
+                    gauss += gaussWeights[i / 2] * sum;
+            }
+
+            const double mean = kronrod / 2;
+            double deviation = kronrodWeights[7] * std::abs(values[14] - mean);
+            for (size_t i = 0; i < 7; i++) {
+                deviation += kronrodWeights[i] * (std::abs(values[2 * i] - mean) + std::abs(values[2 * i + 1] - mean));
+            }
+
+            kronrod *= halfLength;
+            absolute *= std::abs(halfLength);
+            deviation *= std::abs(halfLength);
+
+            if (!std::isfinite(kronrod))
+                throw std::runtime_error("The integrand is not finite on the interval [" + std::to_string(a) + ", " + std::to_string(b) + "]");
+
+            // error estimate of QUADPACK
+            double error = std::abs((kronrod - gauss * halfLength));
+            if (deviation != 0 && error != 0)
+                error = deviation * std::min(1.0, std::pow(200 * error / deviation, 1.5));
+
+            constexpr double epsilon = std::numeric_limits<double>::epsilon();
+            if (absolute > std::numeric_limits<double>::min() / (50 * epsilon))
+                error = std::max(50 * epsilon * absolute, error);
+
+            return Interval{a, b, kronrod, error};
+        }
+    } // namespace
+
+    IntegrationResult integrate(const CompiledExpression& integrand, double a, double b, const IntegrationOptions& options) {
+        if (!std::isfinite(a) || !std::isfinite(b))
+            throw std::runtime_error("The integration bounds have to be finite");
+
+        if (a == b)
+            return IntegrationResult{0, 0, 0, 0, true};
+
+        // max heap ordered by the error estimates
+        std::vector<Interval> intervals = {evaluateInterval(integrand, a, b)};
+
+        IntegrationResult result{intervals.front().value, intervals.front().error, kronrodPoints, 1, false};
+
+        // intervals that are too small to be bisected are not refined any further
+        double finishedValue = 0;
+        double finishedError = 0;
+
+        ThreadPool& pool = ThreadPool::shared();
+        std::vector<Interval> selected;
+        std::vector<Interval> halves;
+
+        while (true) {
+            checkCancellation();
+
+            if (result.error <= std::max(options.absoluteTolerance, options.relativeTolerance * std::abs(result.value))) {
+                result.converged = true;
+                break;
+            }
+
+            if (intervals.empty() || result.intervals >= options.maxIntervals)
+                break;
+
+            // only intervals with errors close to the largest one are refined in the same round, otherwise a singularity
+            // would cause a lot of unnecessary bisections
+            selected.clear();
+            const double minError = intervals.front().error / intervalsPerRound;
+            while (!intervals.empty() && selected.size() < intervalsPerRound && result.intervals + selected.size() < options.maxIntervals &&
+                   intervals.front().error >= minError) {
+                std::pop_heap(intervals.begin(), intervals.end());
+                const Interval interval = intervals.back();
+                intervals.pop_back();
+
+                const double center = (interval.a + interval.b) / 2;
+                if (center == interval.a || center == interval.b) {
+                    finishedValue += interval.value;
+                    finishedError += interval.error;
+                }
+                else {
+                    selected.push_back(interval);
+                }
+            }
+
+            halves.resize(2 * selected.size());
+            pool.parallelFor(0, halves.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const Interval& parent = selected[i / 2];
+                    const double center = (parent.a + parent.b) / 2;
+
+                    halves[i] = i % 2 == 0 ? evaluateInterval(integrand, parent.a, center) : evaluateInterval(integrand, center, parent.b);
+                }
+            });
+
+            for (const Interval& half : halves) {
+                intervals.push_back(half);
+                std::push_heap(intervals.begin(), intervals.end());
+            }
+
+            result.evaluations += halves.size() * kronrodPoints;
+            result.intervals += selected.size();
+
+            // sum up from scratch to avoid accumulating rounding errors
+            result.value = finishedValue;
+            result.error = finishedError;
+            for (const Interval& interval : intervals) {
+                result.value += interval.value;
+                result.error += interval.error;
+            }
+        }
+
+        return result;
+    }
+
+    IntegrationResult integrate(const Expression* expr, const Variable& var, double a, double b, const IntegrationOptions& options) {
+        return integrate(CompiledExpression(expr, {var}), a, b, options);
+    }
+} // namespace cas::math
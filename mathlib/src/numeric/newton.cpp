@@ -0,0 +1,196 @@
+#include "numeric/newton.hpp"
+
+#include "operators/differential.hpp"
+#include "parallel/cancellation.hpp"
+#include "parallel/threadPool.hpp"
+
+#include <cmath>
+#include <memory>
+
+namespace cas::math {
+    namespace {
+        double norm(const std::vector<double>& values) {
+            double sum = 0;
+            for (double value : values) {
+                sum += value * value;
+            }
+
+            return std::sqrt(sum);
+        }
+
+        // solves matrix * x = rhs with gaussian elimination and partial pivoting. The matrix is stored row major.
+        bool solveLinear(std::vector<double> matrix, std::vector<double>& rhs) {
+            const size_t n = rhs.size();
+
+            for (size_t column = 0; column < n; column++) {
+                size_t pivot = column;
+                for (size_t row = column + 1; row < n; row++) {
+                    if (std::abs(matrix[row * n + column]) > std::abs(matrix[pivot * n + column]))
+                        pivot = row;
+                }
+
+                if (matrix[pivot * n + column] == 0 || !std::isfinite(matrix[pivot * n + column]))
+                    return false;
+
+                if (pivot != column) {
+                    for (size_t i = 0; i < n; i++) {
+                        std::swap(matrix[pivot * n + i], matrix[column * n + i]);
+                    }
+                    std::swap(rhs[pivot], rhs[column]);
+                }
+
+                for (size_t row = column + 1; row < n; row++) {
+                    const double factor = matrix[row * n + column] / matrix[column * n + column];
+                    if (factor == 0)
+                        continue;
+
+                    for (size_t i = column; i < n; i++) {
+                        matrix[row * n + i] -= factor * matrix[column * n + i];
+                    }
+                    rhs[row] -= factor * rhs[column];
+                }
+            }
+
+            for (size_t row = n; row-- > 0;) {
+                double sum = rhs[row];
+                for (size_t i = row + 1; i < n; i++) {
+                    sum -= matrix[row * n + i] * rhs[i];
+                }
+
+                rhs[row] = sum / matrix[row * n + row];
+            }
+
+            return true;
+        }
+    } // namespace
+
+    NonlinearSystem::NonlinearSystem(const std::vector<Expression*>& equations, const std::vector<Variable>& variables)
+        : variables(variables) {
+        if (equations.size() != variables.size())
+            throw std::runtime_error("The number of equations has to match the number of variables");
+
+        residuals.reserve(equations.size());
+        jacobian.reserve(equations.size() * variables.size());
+
+        for (const Expression* equation : equations) {
+            residuals.emplace_back(equation, variables);
+        }
+
+        std::vector<Expression*> derivatives = math::jacobian(equations, variables);
+        try {
+            for (const Expression* derivative : derivatives) {
+                jacobian.emplace_back(derivative, variables);
+            }
+        }
+        catch (...) {
+            for (Expression* derivative : derivatives) {
+                delete derivative;
+            }
+            throw;
+        }
+
+        for (Expression* derivative : derivatives) {
+            delete derivative;
+        }
+    }
+
+    const std::vector<Variable>& NonlinearSystem::getVariables() const {
+        return variables;
+    }
+
+    void NonlinearSystem::evaluateResiduals(const std::vector<double>& x, std::vector<double>& result) const {
+        for (size_t i = 0; i < residuals.size(); i++) {
+            result[i] = residuals[i].evaluate(x.data());
+        }
+    }
+
+    void NonlinearSystem::evaluateJacobian(const std::vector<double>& x, std::vector<double>& result) const {
+        for (size_t i = 0; i < jacobian.size(); i++) {
+            result[i] = jacobian[i].evaluate(x.data());
+        }
+    }
+
+    NewtonSolution NonlinearSystem::solve(const std::vector<double>& start, const NewtonOptions& options) const {
+        const size_t n = variables.size();
+        if (start.size() != n)
+            throw std::runtime_error("The starting point needs a value for every variable");
+
+        std::vector<double> x = start;
+        std::vector<double> f(n), trialF(n), trialX(n), step(n), matrix(n * n);
+
+        evaluateResiduals(x, f);
+        double residual = norm(f);
+
+        NewtonSolution solution{false, false, 0, residual, {}};
+
+        for (int iteration = 1; iteration <= options.maxIterations && std::isfinite(residual); iteration++) {
+            checkCancellation();
+            solution.iterations = iteration;
+
+            if (residual <= options.tolerance) {
+                solution.converged = true;
+                break;
+            }
+
+            evaluateJacobian(x, matrix);
+            for (size_t i = 0; i < n; i++) {
+                step[i] = -f[i];
+            }
+
+            if (!solveLinear(matrix, step))
+                break;
+
+            // damping: halve the step until the residual decreases sufficiently
+            double damping = 1;
+            double trialResidual;
+            while (true) {
+                for (size_t i = 0; i < n; i++) {
+                    trialX[i] = x[i] + damping * step[i];
+                }
+
+                evaluateResiduals(trialX, trialF);
+                trialResidual = norm(trialF);
+
+                if ((std::isfinite(trialResidual) && trialResidual <= (1 - 1e-4 * damping) * residual) || damping <= options.minDamping)
+                    break;
+
+                damping /= 2;
+            }
+
+            const double stepSize = damping * norm(step);
+            x.swap(trialX);
+            f.swap(trialF);
+            residual = trialResidual;
+
+            // the iteration stagnates, e.g. because the residual can not be evaluated more accurately
+            if (stepSize <= options.tolerance * (1 + norm(x))) {
+                solution.stalled = residual > options.tolerance;
+                break;
+            }
+        }
+
+        solution.converged |= residual <= options.tolerance;
+        solution.residual = residual;
+        for (size_t i = 0; i < n; i++) {
+            solution.values[variables[i].getSymbol()] = x[i];
+        }
+
+        return solution;
+    }
+
+    std::vector<NewtonSolution> NonlinearSystem::solve(const std::vector<std::vector<double>>& starts, const NewtonOptions& options) const {
+        std::vector<NewtonSolution> solutions(starts.size());
+
+        ThreadPool::shared().parallelFor(0, starts.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                solutions[i] = solve(starts[i], options);
+            }
+        });
+
+        return solutions;
+    }
+
+    std::vector<NewtonSolution> nsolve(const std::vector<Expression*>& equations, const std::vector<Variable>& variables, const std::vector<std::vector<double>>& starts) {
+        return NonlinearSystem(equations, variables).solve(starts);
+    }
+} // namespace cas::math
@@ -0,0 +1,288 @@
+#include "numeric/polynomialRoots.hpp"
+
+#include "expressions/expressions.hpp"
+#include "parallel/cancellation.hpp"
+#include "parallel/threadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <numbers>
+#include <string>
+
+namespace cas::math {
+    namespace {
+        using complex = std::complex<double>;
+
+        // below this degree the root updates are cheaper than distributing them to the thread pool
+        constexpr size_t parallelDegree = 64;
+
+        // upper bound of the degree of expanded polynomials. Checked before a product or power is expanded
+        constexpr size_t maxDegree = 4096;
+
+        void checkDegree(double degree) {
+            if (degree > maxDegree)
+                throw std::runtime_error("The degree of the polynomial exceeds the maximum of " + std::to_string(maxDegree));
+        }
+
+        std::vector<double> addCoefficients(std::vector<double> left, const std::vector<double>& right) {
+            if (left.size() < right.size())
+                left.resize(right.size(), 0);
+
+            for (size_t i = 0; i < right.size(); i++) {
+                left[i] += right[i];
+            }
+
+            return left;
+        }
+
+        std::vector<double> multiplyCoefficients(const std::vector<double>& left, const std::vector<double>& right) {
+            std::vector<double> result(left.size() + right.size() - 1, 0);
+
+            for (size_t i = 0; i < left.size(); i++) {
+                checkCancellation();
+
+                for (size_t j = 0; j < right.size(); j++) {
+                    result[i + j] += left[i] * right[j];
+                }
+            }
+
+            return result;
+        }
+
+        // calculates p(z)/p'(z). For |z| > 1 the reversed polynomial is evaluated at 1/z to avoid overflows
+        complex newtonCorrection(const std::vector<double>& coefficients, complex z) {
+            const size_t degree = coefficients.size() - 1;
+
+            if (std::abs(z) <= 1) {
+                complex value = coefficients[degree];
+                complex derivative = 0;
+
+                for (size_t i = degree; i-- > 0;) {
+                    derivative = derivative * z + value;
+                    value = value * z + coefficients[i];
+                }
+
+                return value / derivative;
+            }
+
+            // p(z) = z^n q(w), p'(z) = z^(n-1) (n q(w) - w q'(w)) with w = 1/z and q(w) = sum c_(n-k) w^k
+            const complex w = 1.0 / z;
+            complex value = coefficients[0];
+            complex derivative = 0;
+
+            for (size_t i = 1; i <= degree; i++) {
+                derivative = derivative * w + value;
+                value = value * w + coefficients[i];
+            }
+
+            return 1.0 / (w * (static_cast<double>(degree) - w * derivative / value));
+        }
+
+        // calculates the logarithm of |p(z)| plus the rounding error bound of the horner scheme. Near a multiple root the computed
+        // value is only rounding noise and may even be exactly zero. Like above the reversed polynomial is used for |z| > 1
+        double logResidualBound(const std::vector<double>& coefficients, complex z) {
+            const size_t degree = coefficients.size() - 1;
+            const double gamma = 2 * degree * std::numeric_limits<double>::epsilon();
+
+            if (std::abs(z) <= 1) {
+                complex value = coefficients[degree];
+                double absValue = std::abs(coefficients[degree]);
+                for (size_t i = degree; i-- > 0;) {
+                    value = value * z + coefficients[i];
+                    absValue = absValue * std::abs(z) + std::abs(coefficients[i]);
+                }
+
+                return std::log(std::abs(value) + gamma * absValue);
+            }
+
+            const complex w = 1.0 / z;
+            complex value = coefficients[0];
+            double absValue = std::abs(coefficients[0]);
+            for (size_t i = 1; i <= degree; i++) {
+                value = value * w + coefficients[i];
+                absValue = absValue * std::abs(w) + std::abs(coefficients[i]);
+            }
+
+            return degree * std::log(std::abs(z)) + std::log(std::abs(value) + gamma * absValue);
+        }
+
+        // radius n (|p(z_i)| + e) / |prod_(j != i) (z_i - z_j)| with the rounding error e of p(z_i) of a disk around z_i that contains a root of the monic polynomial p.
+        // Approximations of a multiple root are close to each other, so the radius stays large until the cluster is resolved
+        double inclusionRadius(const std::vector<double>& coefficients, const std::vector<complex>& approximations, size_t i) {
+            double logRadius = logResidualBound(coefficients, approximations[i]);
+            for (size_t j = 0; j < approximations.size(); j++) {
+                if (j != i)
+                    logRadius -= std::log(std::abs(approximations[i] - approximations[j]));
+            }
+
+            return approximations.size() * std::exp(logRadius);
+        }
+    } // namespace
+
+    std::vector<double> getCoefficients(const Expression* expr, const Variable& var) {
+        if (!expr->dependsOn(var)) {
+            return {expr->getValue().realValue};
+        }
+
+        switch (expr->getType()) {
+            case ExpressionTypes::Variable:
+                return {0, 1};
+            case ExpressionTypes::Addition: {
+                const Addition* addition = static_cast<const Addition*>(expr);
+                return addCoefficients(getCoefficients(addition->left, var), getCoefficients(addition->right, var));
+            }
+            case ExpressionTypes::Multiplication: {
+                const Multiplication* multiplication = static_cast<const Multiplication*>(expr);
+                std::vector<double> left = getCoefficients(multiplication->left, var);
+                std::vector<double> right = getCoefficients(multiplication->right, var);
+                checkDegree(left.size() + right.size() - 2);
+
+                return multiplyCoefficients(left, right);
+            }
+            case ExpressionTypes::Exponentiation: {
+                const Exponentiation* exp = static_cast<const Exponentiation*>(expr);
+                if (exp->right->dependsOn(var))
+                    break;
+
+                const double exponent = exp->right->getValue().realValue;
+                if (exponent < 0 || std::floor(exponent) != exponent)
+                    break;
+
+                // the exponent is checked on its own first, so it fits into size_t
+                checkDegree(exponent);
+                std::vector<double> base = getCoefficients(exp->left, var);
+                checkDegree((base.size() - 1) * exponent);
+
+                std::vector<double> result = {1};
+                for (size_t n = static_cast<size_t>(exponent); n > 0; n >>= 1) {
+                    if (n & 1)
+                        result = multiplyCoefficients(result, base);
+
+                    if (n > 1)
+                        base = multiplyCoefficients(base, base);
+                }
+
+                return result;
+            }
+            default: break;
+        }
+
+        throw std::runtime_error(expr->toString() + " is not a polynomial in " + var.getSymbol());
+    }
+
+    std::vector<PolynomialRoot> findRoots(std::vector<double> coefficients, double tolerance, int maxIterations) {
+        while (!coefficients.empty() && coefficients.back() == 0) {
+            coefficients.pop_back();
+        }
+
+        if (coefficients.empty())
+            throw std::runtime_error("The zero polynomial has no isolated roots");
+
+        // roots at zero
+        std::vector<PolynomialRoot> result;
+        size_t zeroRoots = 0;
+        while (coefficients[zeroRoots] == 0) {
+            zeroRoots++;
+        }
+        coefficients.erase(coefficients.begin(), coefficients.begin() + zeroRoots);
+        result.assign(zeroRoots, PolynomialRoot{Complex(0, 0), true});
+
+        const size_t degree = coefficients.size() - 1;
+        if (degree == 0)
+            return result;
+
+        const double lead = coefficients.back();
+        for (double& coefficient : coefficients) {
+            coefficient /= lead;
+        }
+
+        // initial values on a circle with the geometric mean of the absolute values of the roots as radius
+        const double radius = std::pow(std::abs(coefficients.front()), 1.0 / degree);
+        std::vector<complex> approximations(degree);
+        for (size_t i = 0; i < degree; i++) {
+            approximations[i] = std::polar(radius, 2 * std::numbers::pi * i / degree + 0.4);
+        }
+
+        // aberth-ehrlich iteration. All corrections of one step are calculated from the previous approximations,
+        // so the roots can be updated independently
+        std::vector<complex> corrections(degree);
+        std::vector<char> converged(degree, false);
+
+        auto updateRoots = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                if (converged[i]) {
+                    corrections[i] = 0;
+                    continue;
+                }
+
+                const complex z = approximations[i];
+                const complex ratio = newtonCorrection(coefficients, z);
+
+                complex sum = 0;
+                for (size_t j = 0; j < degree; j++) {
+                    if (j != i)
+                        sum += 1.0 / (z - approximations[j]);
+                }
+
+                corrections[i] = ratio / (1.0 - ratio * sum);
+                if (!std::isfinite(corrections[i].real()) || !std::isfinite(corrections[i].imag()))
+                    corrections[i] = ratio;
+            }
+        };
+
+        ThreadPool& pool = ThreadPool::shared();
+        const size_t grainSize = std::max<size_t>(16, degree / (4 * pool.getThreadCount()));
+
+        for (int iteration = 0; iteration < maxIterations; iteration++) {
+            checkCancellation();
+
+            if (degree >= parallelDegree)
+                pool.parallelFor(0, degree, updateRoots, grainSize);
+            else
+                updateRoots(0, degree);
+
+            bool done = true;
+            for (size_t i = 0; i < degree; i++) {
+                if (converged[i])
+                    continue;
+
+                approximations[i] -= corrections[i];
+                if (std::abs(corrections[i]) <= tolerance * std::max(1.0, std::abs(approximations[i])))
+                    converged[i] = true;
+                else
+                    done = false;
+            }
+
+            if (done)
+                break;
+        }
+
+        for (size_t i = 0; i < degree; i++) {
+            checkCancellation();
+            const complex& z = approximations[i];
+
+            // small corrections do not imply accurate roots: at a multiple root the iteration stalls with an error far above the
+            // tolerance. A root is only reported as converged if the inclusion disk is within the threshold of the rounding noise
+            const double threshold = 1e3 * tolerance * std::max(1.0, std::abs(z));
+            const bool accurate = converged[i] && inclusionRadius(coefficients, approximations, i) <= threshold;
+
+            // remove rounding noise of real and purely imaginary roots
+            result.push_back({Complex(std::abs(z.real()) < threshold ? 0 : z.real(), std::abs(z.imag()) < threshold ? 0 : z.imag()), accurate});
+        }
+
+        std::sort(result.begin(), result.end(), [](const PolynomialRoot& left, const PolynomialRoot& right) {
+            if (left.value.realValue != right.value.realValue)
+                return left.value.realValue < right.value.realValue;
+
+            return left.value.imaginary < right.value.imaginary;
+        });
+
+        return result;
+    }
+
+    std::vector<PolynomialRoot> roots(const Expression* expr, const Variable& var) {
+        return findRoots(getCoefficients(expr, var));
+    }
+} // namespace cas::math
@@ -0,0 +1,183 @@
+#include "numeric/sweep.hpp"
+
+#include "parallel/cancellation.hpp"
+#include "parallel/threadPool.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace cas::math {
+    namespace {
+        constexpr size_t blockSize = 4096;
+
+        inline void appendText(std::string& out, double value) {
+            char buffer[32];
+            const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, end);
+        }
+
+        inline void appendBinary(std::string& out, double value) {
+            uint64_t bits = std::bit_cast<uint64_t>(value);
+            if constexpr (std::endian::native == std::endian::big)
+                bits = std::byteswap(bits);
+
+            out.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+        }
+
+        // evaluates the points [first, last) and formats them into out
+        void evaluateBlock(const CompiledExpression& compiled, const std::vector<SweepAxis>& axes, size_t first, size_t last, SweepFormat format,
+                           std::string& out) {
+            const size_t dimension = axes.size();
+            const size_t count = last - first;
+
+            std::vector<double> coordinates(count * dimension);
+            std::vector<double> values(count);
+
+            for (size_t point = 0; point < count; point++) {
+                size_t index = first + point;
+                for (size_t axis = dimension; axis-- > 0;) {
+                    coordinates[point * dimension + axis] = axes[axis].getValue(index % axes[axis].count);
+                    index /= axes[axis].count;
+                }
+            }
+
+            compiled.evaluate(coordinates.data(), count, values.data());
+
+            out.clear();
+            for (size_t point = 0; point < count; point++) {
+                for (size_t axis = 0; axis < dimension; axis++) {
+                    if (format == SweepFormat::Csv) {
+                        appendText(out, coordinates[point * dimension + axis]);
+                        out += ',';
+                    }
+                    else {
+                        appendBinary(out, coordinates[point * dimension + axis]);
+                    }
+                }
+
+                if (format == SweepFormat::Csv) {
+                    appendText(out, values[point]);
+                    out += '\n';
+                }
+                else {
+                    appendBinary(out, values[point]);
+                }
+            }
+        }
+    } // namespace
+
+    double SweepAxis::getValue(size_t index) const {
+        if (count <= 1)
+            return begin;
+
+        return begin + (end - begin) * static_cast<double>(index) / static_cast<double>(count - 1);
+    }
+
+    namespace {
+        // checks the axes and returns the number of points of the grid
+        size_t countPoints(const std::vector<SweepAxis>& axes) {
+            if (axes.empty())
+                throw std::runtime_error("The sweep needs at least one variable");
+
+            size_t pointCount = 1;
+            for (const SweepAxis& axis : axes) {
+                if (axis.count == 0)
+                    throw std::runtime_error("The number of points of " + axis.variable.getSymbol() + " has to be positive");
+                if (pointCount > SIZE_MAX / axis.count)
+                    throw std::runtime_error("The grid has too many points");
+
+                pointCount *= axis.count;
+            }
+
+            return pointCount;
+        }
+
+        std::vector<Variable> getVariables(const std::vector<SweepAxis>& axes) {
+            std::vector<Variable> variables;
+            for (const SweepAxis& axis : axes) {
+                variables.push_back(axis.variable);
+            }
+
+            return variables;
+        }
+
+        void writePoints(const CompiledExpression& compiled, const std::vector<SweepAxis>& axes, size_t pointCount, std::ostream& stream,
+                         SweepFormat format) {
+            if (format == SweepFormat::Csv) {
+                for (const SweepAxis& axis : axes) {
+                    stream << axis.variable.getSymbol() << ',';
+                }
+                stream << "value\n";
+            }
+
+            // the blocks of one round are evaluated in parallel and written before the next round starts
+            ThreadPool& pool = ThreadPool::shared();
+            const size_t blockCount = (pointCount + blockSize - 1) / blockSize;
+            const size_t roundSize = std::max<size_t>(2 * pool.getThreadCount(), 1);
+            std::vector<std::string> blocks(std::min(roundSize, blockCount));
+
+            for (size_t round = 0; round < blockCount; round += roundSize) {
+                checkCancellation();
+
+                const size_t roundEnd = std::min(round + roundSize, blockCount);
+                pool.parallelFor(round, roundEnd, [&](size_t begin, size_t end) {
+                    for (size_t block = begin; block < end; block++) {
+                        const size_t first = block * blockSize;
+                        evaluateBlock(compiled, axes, first, std::min(first + blockSize, pointCount), format, blocks[block - round]);
+                    }
+                });
+
+                for (size_t block = round; block < roundEnd; block++) {
+                    stream.write(blocks[block - round].data(), blocks[block - round].size());
+                }
+
+                if (!stream)
+                    throw std::runtime_error("Could not write the results of the sweep");
+            }
+        }
+    } // namespace
+
+    size_t sweep(const Expression* expr, const std::vector<SweepAxis>& axes, std::ostream& stream, SweepFormat format) {
+        const size_t pointCount = countPoints(axes);
+        const CompiledExpression compiled(expr, getVariables(axes));
+
+        writePoints(compiled, axes, pointCount, stream, format);
+        return pointCount;
+    }
+
+    size_t sweep(const Expression* expr, const std::vector<SweepAxis>& axes, const std::string& path, SweepFormat format) {
+        const size_t pointCount = countPoints(axes);
+        const CompiledExpression compiled(expr, getVariables(axes));
+
+        // like a snapshot the results are written to a temporary file first, so the file is only replaced by a complete sweep
+        const std::string temporaryPath = path + ".tmp";
+        std::error_code error;
+        try {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+                throw std::runtime_error("Could not open " + temporaryPath);
+
+            writePoints(compiled, axes, pointCount, file, format);
+
+            if (!file.flush())
+                throw std::runtime_error("Could not write the results of the sweep");
+        }
+        catch (...) {
+            std::filesystem::remove(temporaryPath, error);
+            throw;
+        }
+
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error) {
+            std::filesystem::remove(temporaryPath, error);
+            throw std::runtime_error("Could not write " + path);
+        }
+
+        return pointCount;
+    }
+} // namespace cas::math
@@ -1,16 +1,22 @@
 #include "operators/differential.hpp"
 
+#include "parallel/cancellation.hpp"
+#include "parallel/threadPool.hpp"
+
 #include <map>
+#include <memory>
 #include <set>
 
 namespace cas::math {
-    Expression* D(Expression* expr) {
-        std::set<Variable> variables = expr->getVariables();
+    Expression* D(const Expression* expr) {
+        const std::set<Variable> variableSet = expr->getVariables();
+        const std::vector<Variable> variables(variableSet.begin(), variableSet.end());
 
-        std::map<Variable, Expression*> derivatives;
+        std::vector<Expression*> partials = partialDerivatives(expr, variables, true);
 
-        for (const auto& var : variables) {
-            derivatives[var] = D(expr, Variable(var))->simplify();
+        std::map<Variable, Expression*> derivatives;
+        for (size_t i = 0; i < variables.size(); i++) {
+            derivatives[variables[i]] = partials[i];
         }
 
         if (derivatives.size() > 0) {
@@ -35,32 +41,96 @@ namespace cas::math {
         return new Number(0);
     }
 
-    Expression* D(Expression* expr, const Variable& var) {
+    namespace {
+        // every entry is written by one task only. The expressions are shared by all tasks, differentiation does not
+        // change them
+        template<typename Derive>
+        std::vector<Expression*> differentiateEntries(const std::vector<Expression*>& expressions, const std::vector<Variable>& variables, Derive derive) {
+            std::vector<Expression*> result(expressions.size() * variables.size(), nullptr);
+            if (result.empty())
+                return result;
+
+            try {
+                ThreadPool::shared().parallelFor(0, result.size(), [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        result[i] = derive(expressions[i / variables.size()], variables[i % variables.size()]);
+                    }
+                });
+            }
+            catch (...) {
+                for (Expression* entry : result) {
+                    delete entry;
+                }
+                throw;
+            }
+
+            return result;
+        }
+    } // namespace
+
+    std::vector<Expression*> partialDerivatives(const Expression* expr, const std::vector<Variable>& variables, bool simplify) {
+        return jacobian({const_cast<Expression*>(expr)}, variables, simplify);
+    }
+
+    std::vector<Expression*> differentiateAll(const Expression* expr, const std::vector<Variable>& variables) {
+        return differentiateEntries({const_cast<Expression*>(expr)}, variables, [](const Expression* expr, const Variable& var) {
+            return expr->differentiate(&var);
+        });
+    }
+
+    std::vector<Expression*> jacobian(const std::vector<Expression*>& expressions, const std::vector<Variable>& variables, bool simplify) {
+        return differentiateEntries(expressions, variables, [simplify](const Expression* expr, const Variable& var) {
+            Expression* derivative = D(expr, var);
+            if (simplify) {
+                std::unique_ptr<Expression> unsimplified(derivative);
+                derivative = unsimplified->simplify();
+            }
+
+            return derivative;
+        });
+    }
+
+    Expression* D(const Expression* expr, const Variable& var) {
+        checkCancellation();
+
         if (!expr->dependsOn(var)) {
             return new Number(0);
         }
 
+        // the operands are owned until the node is created, so nothing is leaked if the resource budget is exhausted
+        std::unique_ptr<Expression> dLeft;
+        std::unique_ptr<Expression> dRight;
+        std::unique_ptr<Expression> leftCopy;
+        std::unique_ptr<Expression> rightCopy;
+        std::unique_ptr<Expression> left;
+        std::unique_ptr<Expression> right;
+
         Expression* result = nullptr;
-        Addition* addition;
-        Multiplication* multiplication;
-        Exponentiation* exponentiation;
+        const Addition* addition;
+        const Multiplication* multiplication;
+        const Exponentiation* exponentiation;
         const Variable* variable;
-        Expression* dLeft;
-        Expression* dRight;
         switch (expr->getType()) {
             case ExpressionTypes::Addition:
-                addition = reinterpret_cast<Addition*>(expr);
-                result = new Addition(D(addition->left, var), D(addition->right, var));
+                addition = reinterpret_cast<const Addition*>(expr);
+                dLeft.reset(D(addition->left, var));
+                dRight.reset(D(addition->right, var));
+
+                result = makeNode<Addition>(dLeft, dRight);
                 break;
             case ExpressionTypes::Multiplication:
-                multiplication = reinterpret_cast<Multiplication*>(expr);
-                dLeft = D(multiplication->left, var);
-                dRight = D(multiplication->right, var);
-
-                result = new Addition(new Multiplication(dLeft, multiplication->right->copy()), new Multiplication(multiplication->left->copy(), dRight));
+                multiplication = reinterpret_cast<const Multiplication*>(expr);
+                dLeft.reset(D(multiplication->left, var));
+                dRight.reset(D(multiplication->right, var));
+                leftCopy.reset(multiplication->left->copy());
+                rightCopy.reset(multiplication->right->copy());
+
+                left.reset(makeNode<Multiplication>(dLeft, rightCopy));
+                right.reset(makeNode<Multiplication>(leftCopy, dRight));
+                result = makeNode<Addition>(left, right);
                 break;
             case ExpressionTypes::Variable:
-                variable = reinterpret_cast<Variable*>(expr);
+                variable = reinterpret_cast<const Variable*>(expr);
                 if (variable->getSymbol() == var.getSymbol()) {
                     result = new Number(1);
                 }
@@ -69,29 +139,36 @@ namespace cas::math {
                 }
                 break;
             case ExpressionTypes::Exponentiation:
-                exponentiation = reinterpret_cast<Exponentiation*>(expr);
+                exponentiation = reinterpret_cast<const Exponentiation*>(expr);
                 if (exponentiation->right->getType() == ExpressionTypes::Constant) {
-                    Number exponentValue = exponentiation->right->getValue();
+                    const double exponentValue = exponentiation->right->getValue();
                     if (exponentValue == 0) {
                         return new Number(0);
                     }
                     else {
-                        result = new Multiplication(new Number(exponentValue), new Multiplication(new Exponentiation(exponentiation->left->copy(), new Number(exponentValue - 1.0)), D(exponentiation->left, var)));
+                        leftCopy.reset(exponentiation->left->copy());
+                        rightCopy.reset(new Number(exponentValue - 1.0));
+                        dLeft.reset(D(exponentiation->left, var));
+
+                        left.reset(makeNode<Exponentiation>(leftCopy, rightCopy));
+                        right.reset(makeNode<Multiplication>(left, dLeft));
+                        left.reset(new Number(exponentValue));
+                        result = makeNode<Multiplication>(left, right);
                     }
                 }
                 else {
                     // base transform (a^b = e^(ln(a)*b))
-                    Expression* baseLn = new Ln(exponentiation->left->copy());
-                    Expression* eExponent = new Multiplication(baseLn, exponentiation->right->copy());
-
-                    result = new Multiplication(exponentiation->copy(), D(eExponent, var));
+                    leftCopy.reset(new Ln(exponentiation->left));
+                    rightCopy.reset(exponentiation->right->copy());
+                    const std::unique_ptr<Expression> eExponent(makeNode<Multiplication>(leftCopy, rightCopy));
 
-                    // delete eExponent and baseLn (baseLn is left of eExponent and gets deleted if the destructor of eExponent is called)
-                    delete eExponent;
+                    left.reset(exponentiation->copy());
+                    right.reset(D(eExponent.get(), var));
+                    result = makeNode<Multiplication>(left, right);
                 }
                 break;
             case ExpressionTypes::Function:
-                result = reinterpret_cast<BaseFunction*>(expr)->differentiate(&var);
+                result = reinterpret_cast<const BaseFunction*>(expr)->differentiate(&var);
                 break;
             default:
                 return nullptr;
@@ -0,0 +1,391 @@
+#include "operators/series.hpp"
+
+#include "expressions/resourceBudget.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace cas::math {
+#pragma region PowerSeries
+    PowerSeries::PowerSeries(size_t order, double constant)
+        : coefficients(order + 1, 0) {
+        coefficients[0] = constant;
+    }
+
+    PowerSeries PowerSeries::variable(size_t order, double x0) {
+        PowerSeries result(order, x0);
+        if (order > 0)
+            result[1] = 1;
+
+        return result;
+    }
+
+    size_t PowerSeries::getOrder() const {
+        return coefficients.size() - 1;
+    }
+
+    const std::vector<double>& PowerSeries::getCoefficients() const {
+        return coefficients;
+    }
+
+    double PowerSeries::operator[](size_t k) const {
+        return coefficients[k];
+    }
+
+    double& PowerSeries::operator[](size_t k) {
+        return coefficients[k];
+    }
+
+    PowerSeries PowerSeries::derivative() const {
+        const size_t n = getOrder();
+        PowerSeries result(n);
+
+        // the highest coefficient of the derivative is unknown and stays zero
+        for (size_t k = 1; k <= n; k++) {
+            result[k - 1] = k * coefficients[k];
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::integral(double constant) const {
+        const size_t n = getOrder();
+        PowerSeries result(n, constant);
+
+        for (size_t k = 1; k <= n; k++) {
+            result[k] = coefficients[k - 1] / k;
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::operator+(const PowerSeries& other) const {
+        PowerSeries result = *this;
+        for (size_t k = 0; k < coefficients.size(); k++) {
+            result[k] += other[k];
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::operator-(const PowerSeries& other) const {
+        PowerSeries result = *this;
+        for (size_t k = 0; k < coefficients.size(); k++) {
+            result[k] -= other[k];
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::operator*(const PowerSeries& other) const {
+        const size_t n = getOrder();
+        PowerSeries result(n);
+
+        for (size_t i = 0; i <= n; i++) {
+            checkCancellation();
+
+            if (coefficients[i] == 0)
+                continue;
+
+            for (size_t j = 0; i + j <= n; j++) {
+                result[i + j] += coefficients[i] * other[j];
+            }
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::operator/(const PowerSeries& other) const {
+        if (other[0] == 0)
+            throw std::runtime_error("The power series of the divisor has no constant term");
+
+        const size_t n = getOrder();
+        PowerSeries result(n);
+
+        for (size_t k = 0; k <= n; k++) {
+            checkCancellation();
+
+            double sum = coefficients[k];
+            for (size_t j = 1; j <= k; j++) {
+                sum -= other[j] * result[k - j];
+            }
+
+            result[k] = sum / other[0];
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::operator*(double factor) const {
+        PowerSeries result = *this;
+        for (double& coefficient : result.coefficients) {
+            coefficient *= factor;
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::pow(int exponent) const {
+        if (exponent < 0)
+            return PowerSeries(getOrder(), 1) / pow(-exponent);
+
+        PowerSeries result(getOrder(), 1);
+        PowerSeries base = *this;
+
+        while (exponent > 0) {
+            if (exponent & 1)
+                result = result * base;
+
+            exponent >>= 1;
+            if (exponent > 0)
+                base = base * base;
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::pow(double exponent) const {
+        if (std::floor(exponent) == exponent && std::abs(exponent) <= 1024)
+            return pow(static_cast<int>(exponent));
+
+        if (coefficients[0] <= 0)
+            throw std::runtime_error("The power series of a non integer power needs a positive constant term");
+
+        // J.C.P. Miller's recurrence for b = a^exponent
+        const size_t n = getOrder();
+        PowerSeries result(n, std::pow(coefficients[0], exponent));
+
+        for (size_t k = 1; k <= n; k++) {
+            checkCancellation();
+
+            double sum = 0;
+            for (size_t j = 1; j <= k; j++) {
+                sum += ((exponent + 1) * j - k) * coefficients[j] * result[k - j];
+            }
+
+            result[k] = sum / (k * coefficients[0]);
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::exp() const {
+        const size_t n = getOrder();
+        PowerSeries result(n, std::exp(coefficients[0]));
+
+        for (size_t k = 1; k <= n; k++) {
+            checkCancellation();
+
+            double sum = 0;
+            for (size_t j = 1; j <= k; j++) {
+                sum += j * coefficients[j] * result[k - j];
+            }
+
+            result[k] = sum / k;
+        }
+
+        return result;
+    }
+
+    PowerSeries PowerSeries::ln() const {
+        if (coefficients[0] <= 0)
+            throw std::runtime_error("The power series of the logarithm needs a positive constant term");
+
+        const size_t n = getOrder();
+        PowerSeries result(n, std::log(coefficients[0]));
+
+        for (size_t k = 1; k <= n; k++) {
+            checkCancellation();
+
+            double sum = 0;
+            for (size_t j = 1; j < k; j++) {
+                sum += j * result[j] * coefficients[k - j];
+            }
+
+            result[k] = (coefficients[k] - sum / k) / coefficients[0];
+        }
+
+        return result;
+    }
+
+    void PowerSeries::sinCos(PowerSeries& sin, PowerSeries& cos) const {
+        const size_t n = getOrder();
+        sin = PowerSeries(n, std::sin(coefficients[0]));
+        cos = PowerSeries(n, std::cos(coefficients[0]));
+
+        for (size_t k = 1; k <= n; k++) {
+            checkCancellation();
+
+            double sinSum = 0;
+            double cosSum = 0;
+            for (size_t j = 1; j <= k; j++) {
+                sinSum += j * coefficients[j] * cos[k - j];
+                cosSum += j * coefficients[j] * sin[k - j];
+            }
+
+            sin[k] = sinSum / k;
+            cos[k] = -cosSum / k;
+        }
+    }
+
+    void PowerSeries::sinhCosh(PowerSeries& sinh, PowerSeries& cosh) const {
+        const size_t n = getOrder();
+        sinh = PowerSeries(n, std::sinh(coefficients[0]));
+        cosh = PowerSeries(n, std::cosh(coefficients[0]));
+
+        for (size_t k = 1; k <= n; k++) {
+            checkCancellation();
+
+            double sinhSum = 0;
+            double coshSum = 0;
+            for (size_t j = 1; j <= k; j++) {
+                sinhSum += j * coefficients[j] * cosh[k - j];
+                coshSum += j * coefficients[j] * sinh[k - j];
+            }
+
+            sinh[k] = sinhSum / k;
+            cosh[k] = coshSum / k;
+        }
+    }
+#pragma endregion
+
+    namespace {
+        // the inverse functions are calculated by integrating their derivative f'(a) * a'
+        PowerSeries integrateDerivative(const PowerSeries& series, const PowerSeries& outerDerivative, double constant) {
+            return (series.derivative() * outerDerivative).integral(constant);
+        }
+
+        PowerSeries functionSeries(const BaseFunction* function, const PowerSeries& argument) {
+            const std::string& name = function->name;
+            const size_t n = argument.getOrder();
+            const PowerSeries one(n, 1);
+            PowerSeries sin(n), cos(n);
+
+            if (name == "sin" || name == "cos" || name == "tan") {
+                argument.sinCos(sin, cos);
+
+                if (name == "sin")
+                    return sin;
+                if (name == "cos")
+                    return cos;
+
+                return sin / cos;
+            }
+            if (name == "sinh" || name == "cosh") {
+                argument.sinhCosh(sin, cos);
+
+                return name == "sinh" ? sin : cos;
+            }
+            if (name == "ln")
+                return argument.ln();
+            if (name == "arctan")
+                return integrateDerivative(argument, one / (one + argument * argument), std::atan(argument[0]));
+            if (name == "arcsin" || name == "arccos") {
+                if (std::abs(argument[0]) >= 1)
+                    throw std::runtime_error("The power series of " + name + " does not exist at the boundary of its domain");
+
+                const PowerSeries derivative = (one - argument * argument).pow(-0.5);
+                if (name == "arcsin")
+                    return integrateDerivative(argument, derivative, std::asin(argument[0]));
+
+                return integrateDerivative(argument, derivative * -1, std::acos(argument[0]));
+            }
+            if (name == "asinh")
+                return integrateDerivative(argument, (one + argument * argument).pow(-0.5), std::asinh(argument[0]));
+            if (name == "acosh") {
+                if (argument[0] <= 1)
+                    throw std::runtime_error("The power series of acosh needs a constant term greater than one");
+
+                return integrateDerivative(argument, (argument * argument - one).pow(-0.5), std::acosh(argument[0]));
+            }
+
+            throw std::runtime_error("The power series of the function " + name + " is not implemented");
+        }
+
+        PowerSeries expressionSeries(const Expression* expr, const Variable& var, double x0, size_t order) {
+            checkCancellation();
+            DepthGuard depthGuard;
+
+            switch (expr->getType()) {
+                case ExpressionTypes::Constant:
+                case ExpressionTypes::NamedConstant: {
+                    const Complex* complex = dynamic_cast<const Complex*>(expr);
+                    if (complex != nullptr && complex->imaginary != 0)
+                        throw std::runtime_error("Power series with complex coefficients are not supported");
+
+                    return PowerSeries(order, static_cast<const Number*>(expr)->realValue);
+                }
+                case ExpressionTypes::Variable:
+                    if (*static_cast<const Variable*>(expr) == var)
+                        return PowerSeries::variable(order, x0);
+
+                    throw std::runtime_error("Cannot expand " + expr->toString() + " as it depends on another variable");
+                case ExpressionTypes::Addition: {
+                    const Addition* addition = static_cast<const Addition*>(expr);
+                    return expressionSeries(addition->left, var, x0, order) + expressionSeries(addition->right, var, x0, order);
+                }
+                case ExpressionTypes::Multiplication: {
+                    const Multiplication* multiplication = static_cast<const Multiplication*>(expr);
+                    return expressionSeries(multiplication->left, var, x0, order) * expressionSeries(multiplication->right, var, x0, order);
+                }
+                case ExpressionTypes::Exponentiation: {
+                    const Exponentiation* exponentiation = static_cast<const Exponentiation*>(expr);
+
+                    if (!exponentiation->right->dependsOn(var)) {
+                        const double exponent = exponentiation->right->getValue().realValue;
+
+                        // e^a
+                        if (exponentiation->left->getType() == ExpressionTypes::NamedConstant && exponentiation->left->toString() == "e")
+                            return expressionSeries(exponentiation->right, var, x0, order).exp();
+
+                        return expressionSeries(exponentiation->left, var, x0, order).pow(exponent);
+                    }
+
+                    // a^b = e^(b ln(a))
+                    const PowerSeries base = expressionSeries(exponentiation->left, var, x0, order);
+                    const PowerSeries exponent = expressionSeries(exponentiation->right, var, x0, order);
+                    return (exponent * base.ln()).exp();
+                }
+                case ExpressionTypes::Function: {
+                    const PowerSeries argument = expressionSeries(expr->getChildren().front(), var, x0, order);
+                    return functionSeries(static_cast<const BaseFunction*>(expr), argument);
+                }
+                default:
+                    throw std::runtime_error("Cannot expand " + expr->toString() + " into a power series");
+            }
+        }
+    } // namespace
+
+    PowerSeries taylorSeries(const Expression* expr, const Variable& var, double x0, size_t order) {
+        return expressionSeries(expr, var, x0, order);
+    }
+
+    Expression* series(const Expression* expr, const Variable& var, double x0, size_t order) {
+        const PowerSeries taylor = taylorSeries(expr, var, x0, order);
+
+        // build c_0 + c_1 (x - x0) + ... from the highest order so the sum is nested to the right
+        Expression* result = nullptr;
+        for (size_t k = order + 1; k-- > 0;) {
+            const double coefficient = taylor[k];
+            if (coefficient == 0)
+                continue;
+
+            Expression* term;
+            if (k == 0) {
+                term = new Number(coefficient);
+            }
+            else {
+                Expression* base = x0 == 0 ? var.copy() : new Addition(var.copy(), new Number(-x0));
+                term = k == 1 ? base : new Exponentiation(base, new Number(static_cast<double>(k)));
+
+                if (coefficient != 1)
+                    term = new Multiplication(new Number(coefficient), term);
+            }
+
+            result = result == nullptr ? term : new Addition(term, result);
+        }
+
+        return result == nullptr ? new Number(0) : result;
+    }
+} // namespace cas::math
@@ -0,0 +1,45 @@
+#include "parallel/cancellation.hpp"
+
+namespace cas::math {
+    thread_local std::shared_ptr<std::atomic<bool>> CancellationToken::currentFlag;
+
+    operation_cancelled_error::operation_cancelled_error()
+        : std::runtime_error("The operation was cancelled") {
+    }
+
+    CancellationToken::CancellationToken()
+        : cancelled(std::make_shared<std::atomic<bool>>(false)) {
+    }
+
+    CancellationToken::CancellationToken(const std::shared_ptr<std::atomic<bool>>& cancelled)
+        : cancelled(cancelled) {
+    }
+
+    void CancellationToken::cancel() const {
+        if (cancelled)
+            cancelled->store(true, std::memory_order_relaxed);
+    }
+
+    bool CancellationToken::isCancelled() const {
+        return cancelled && cancelled->load(std::memory_order_relaxed);
+    }
+
+    CancellationToken CancellationToken::current() {
+        return CancellationToken(currentFlag);
+    }
+
+    CancellationScope::CancellationScope(const CancellationToken& token)
+        : previous(CancellationToken::currentFlag) {
+        CancellationToken::currentFlag = token.cancelled;
+    }
+
+    CancellationScope::~CancellationScope() {
+        CancellationToken::currentFlag = previous;
+    }
+
+    void checkCancellation() {
+        const std::atomic<bool>* flag = CancellationToken::currentFlag.get();
+        if (flag != nullptr && flag->load(std::memory_order_relaxed))
+            throw operation_cancelled_error();
+    }
+} // namespace cas::math
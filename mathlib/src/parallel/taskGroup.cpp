@@ -0,0 +1,63 @@
+#include "parallel/taskGroup.hpp"
+
+#include "expressions/resourceBudget.hpp"
+
+
+namespace cas::math {
+    TaskGroup::TaskGroup(ThreadPool& pool)
+        : pool(pool), state(std::make_shared<State>()), token(CancellationToken::current()), budget(ResourceBudget::getCurrent()) {
+    }
+
+    TaskGroup::~TaskGroup() {
+        // the tasks can reference local variables of the creator
+        try {
+            wait();
+        }
+        catch (...) {
+        }
+    }
+
+    void TaskGroup::run(std::function<void()> task) {
+        state->pending++;
+
+        pool.submit([state = state, task = std::move(task), token = token, budget = budget]() {
+            CancellationScope scope(token);
+            BudgetScope budgetScope(budget);
+
+            try {
+                if (!state->failed.load())
+                    task();
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->exception)
+                    state->exception = std::current_exception();
+                state->failed = true;
+            }
+
+            // the lock is taken after the counter reached zero, so a waiter can not miss the notification between its
+            // check and its wait
+            if (--state->pending == 0) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        });
+    }
+
+    void TaskGroup::wait() {
+        // helps the pool while tasks are pending and sleeps while the remaining tasks of the group run on other threads
+        while (state->pending.load() > 0) {
+            if (!pool.runPendingTask())
+                break;
+        }
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [this]() { return state->pending.load() == 0; });
+
+        if (state->exception) {
+            std::exception_ptr exception = state->exception;
+            state->exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+} // namespace cas::math
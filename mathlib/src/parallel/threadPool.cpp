@@ -0,0 +1,211 @@
+#include "parallel/threadPool.hpp"
+
+#include "expressions/resourceBudget.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace cas::math {
+    thread_local ThreadPool* ThreadPool::currentPool = nullptr;
+    thread_local size_t ThreadPool::currentWorker = 0;
+
+    ThreadPool::ThreadPool(size_t threadCount) {
+        threadCount = std::max<size_t>(threadCount, 1);
+
+        queues.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++) {
+            queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        workers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; i++) {
+            workers.emplace_back(&ThreadPool::workerLoop, this, i);
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        condition.notify_all();
+
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    size_t ThreadPool::getThreadCount() const {
+        return workers.size();
+    }
+
+    bool ThreadPool::takeTask(std::function<void()>& task) {
+        if (pendingTasks.load() == 0)
+            return false;
+
+        const bool isWorker = currentPool == this;
+        const size_t own = isWorker ? currentWorker : 0;
+
+        // the newest task of the own queue
+        if (isWorker) {
+            WorkerQueue& queue = *queues[own];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                pendingTasks--;
+                return true;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!tasks.empty()) {
+                task = std::move(tasks.front());
+                tasks.pop_front();
+                pendingTasks--;
+                return true;
+            }
+        }
+
+        // steal the oldest task of another worker, it is usually the largest one
+        for (size_t i = 1; i <= queues.size(); i++) {
+            WorkerQueue& queue = *queues[(own + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                pendingTasks--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool ThreadPool::runPendingTask() {
+        std::function<void()> task;
+        if (!takeTask(task))
+            return false;
+
+        task();
+        return true;
+    }
+
+    void ThreadPool::workerLoop(size_t index) {
+        currentPool = this;
+        currentWorker = index;
+
+        while (true) {
+            std::function<void()> task;
+            if (takeTask(task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || pendingTasks.load() > 0; });
+
+            if (stopping && pendingTasks.load() == 0)
+                return;
+        }
+    }
+
+    void ThreadPool::enqueue(std::function<void()> task) {
+        {
+            // the counter is incremented under the lock, so a worker can not miss the notification between its check
+            // and its wait. It is incremented before the task is visible, so it never drops below the number of tasks
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingTasks++;
+
+            if (currentPool != this)
+                tasks.push_back(std::move(task));
+        }
+
+        if (currentPool == this) {
+            WorkerQueue& queue = *queues[currentWorker];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+
+        condition.notify_one();
+    }
+
+    void ThreadPool::parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body, size_t grainSize) {
+        if (begin >= end)
+            return;
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        const size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+
+        if (chunkCount == 1) {
+            body(begin, end);
+            return;
+        }
+
+        struct LoopState {
+            std::atomic<size_t> nextChunk = 0;
+            std::atomic<size_t> finishedChunks = 0;
+            std::atomic<bool> failed = false;
+
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr exception;
+        };
+
+        auto state = std::make_shared<LoopState>();
+
+        // the helpers only run chunks that are not taken yet, so they never wait for each other
+        auto runChunks = [state, begin, end, grainSize, chunkCount, &body]() {
+            size_t chunk;
+            while ((chunk = state->nextChunk.fetch_add(1)) < chunkCount) {
+                const size_t chunkBegin = begin + chunk * grainSize;
+                const size_t chunkEnd = std::min(chunkBegin + grainSize, end);
+
+                // the remaining chunks are skipped after an exception
+                try {
+                    if (!state->failed.load())
+                        body(chunkBegin, chunkEnd);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->exception)
+                        state->exception = std::current_exception();
+                    state->failed = true;
+                }
+
+                if (state->finishedChunks.fetch_add(1) + 1 == chunkCount) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        const size_t helperCount = std::min(chunkCount, workers.size()) - 1;
+        const CancellationToken token = CancellationToken::current();
+        ResourceBudget* budget = ResourceBudget::getCurrent();
+        for (size_t i = 0; i < helperCount; i++) {
+            // body is only used while chunks are left, and the caller waits for all of them to finish. The helpers can
+            // be cancelled together with the caller and count their nodes in the budget of the caller
+            enqueue([state, runChunks, token, budget]() {
+                CancellationScope scope(token);
+                BudgetScope budgetScope(budget);
+                runChunks();
+            });
+        }
+
+        runChunks();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state, chunkCount]() { return state->finishedChunks.load() == chunkCount; });
+
+        if (state->exception)
+            std::rethrow_exception(state->exception);
+    }
+
+    ThreadPool& ThreadPool::shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+} // namespace cas::math
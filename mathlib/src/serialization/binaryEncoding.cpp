@@ -0,0 +1,255 @@
+#include "serialization/binaryEncoding.hpp"
+
+#include "expressions/expressions.hpp"
+#include "expressions/resourceBudget.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <bit>
+#include <cstring>
+#include <sstream>
+
+namespace cas::math {
+    namespace {
+        constexpr char magic[4] = {'C', 'A', 'S', 'E'};
+        constexpr size_t maxVarintBytes = 10;
+
+        inline uint64_t toLittleEndian(uint64_t value) {
+            if constexpr (std::endian::native == std::endian::big)
+                return std::byteswap(value);
+
+            return value;
+        }
+    } // namespace
+
+#pragma region ExpressionWriter
+    ExpressionWriter::ExpressionWriter(std::ostream& stream)
+        : stream(stream) {
+        stream.write(magic, sizeof(magic));
+        writeVarint(version);
+    }
+
+    void ExpressionWriter::writeVarint(uint64_t value) {
+        char bytes[maxVarintBytes];
+        size_t count = 0;
+
+        while (value >= 0x80) {
+            bytes[count++] = static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        bytes[count++] = static_cast<char>(value);
+
+        stream.write(bytes, count);
+    }
+
+    void ExpressionWriter::writeDouble(double value) {
+        const uint64_t bits = toLittleEndian(std::bit_cast<uint64_t>(value));
+        stream.write(reinterpret_cast<const char*>(&bits), sizeof(bits));
+    }
+
+    void ExpressionWriter::writeSymbol(const std::string& symbol) {
+        auto it = symbols.find(symbol);
+        if (it != symbols.end()) {
+            writeVarint(it->second + 1);
+            return;
+        }
+
+        writeVarint(0);
+        writeVarint(symbol.size());
+        stream.write(symbol.data(), symbol.size());
+
+        const uint64_t index = symbols.size();
+        symbols.emplace(symbol, index);
+    }
+
+    void ExpressionWriter::writeNode(const Expression* expr) {
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        const NodeTag tag = getNodeTag(expr);
+        stream.put(static_cast<char>(tag));
+
+        switch (tag) {
+            case NodeTag::Addition:
+            case NodeTag::Multiplication:
+            case NodeTag::Exponentiation:
+            case NodeTag::Function: {
+                const std::vector<Expression*> children = expr->getChildren();
+                writeVarint(children.size());
+
+                if (tag == NodeTag::Function)
+                    writeSymbol(getNodeSymbol(expr));
+
+                for (const Expression* child : children) {
+                    writeNode(child);
+                }
+            } break;
+            case NodeTag::Number: writeDouble(static_cast<const Number*>(expr)->realValue); break;
+            case NodeTag::Complex: {
+                const Complex* complex = static_cast<const Complex*>(expr);
+                writeDouble(complex->realValue);
+                writeDouble(complex->imaginary);
+            } break;
+            case NodeTag::NamedConstant:
+                writeSymbol(getNodeSymbol(expr));
+                writeDouble(static_cast<const Number*>(expr)->realValue);
+                break;
+            case NodeTag::Variable:
+            case NodeTag::Differential: writeSymbol(getNodeSymbol(expr)); break;
+        }
+    }
+
+    void ExpressionWriter::write(const Expression* expr) {
+        writeNode(expr);
+
+        if (!stream)
+            throw serialization_error("Cannot write the expression");
+    }
+#pragma endregion
+
+#pragma region ExpressionReader
+    ExpressionReader::ExpressionReader(const void* data, size_t size)
+        : position(static_cast<const uint8_t*>(data)), end(static_cast<const uint8_t*>(data) + size) {
+        if (size < sizeof(magic) || std::memcmp(data, magic, sizeof(magic)) != 0)
+            throw serialization_error("The data is not an encoded expression");
+
+        position += sizeof(magic);
+        const uint64_t dataVersion = readVarint();
+        if (dataVersion != ExpressionWriter::version)
+            throw serialization_error("Unsupported encoding version " + std::to_string(dataVersion));
+    }
+
+    ExpressionReader::ExpressionReader(std::string_view data)
+        : ExpressionReader(data.data(), data.size()) {
+    }
+
+    uint64_t ExpressionReader::readVarint() {
+        uint64_t value = 0;
+
+        for (size_t i = 0; i < maxVarintBytes; i++) {
+            if (position == end)
+                throw serialization_error("The encoded expression is truncated");
+
+            const uint8_t byte = *position++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+
+        throw serialization_error("Invalid varint in the encoded expression");
+    }
+
+    double ExpressionReader::readDouble() {
+        if (static_cast<size_t>(end - position) < sizeof(uint64_t))
+            throw serialization_error("The encoded expression is truncated");
+
+        uint64_t bits;
+        std::memcpy(&bits, position, sizeof(bits));
+        position += sizeof(bits);
+
+        return std::bit_cast<double>(toLittleEndian(bits));
+    }
+
+    std::string_view ExpressionReader::readSymbol() {
+        const uint64_t reference = readVarint();
+        if (reference > 0) {
+            if (reference > symbols.size())
+                throw serialization_error("Invalid symbol reference in the encoded expression");
+
+            return symbols[reference - 1];
+        }
+
+        const uint64_t length = readVarint();
+        if (length > static_cast<uint64_t>(end - position))
+            throw serialization_error("The encoded expression is truncated");
+
+        const std::string_view symbol(reinterpret_cast<const char*>(position), length);
+        position += length;
+
+        symbols.push_back(symbol);
+        return symbol;
+    }
+
+    Expression* ExpressionReader::readNode() {
+        checkCancellation();
+        DepthGuard depthGuard;
+
+        if (position == end)
+            throw serialization_error("The encoded expression is truncated");
+
+        const uint8_t tagValue = *position++;
+        if (tagValue > static_cast<uint8_t>(NodeTag::Differential))
+            throw serialization_error("Unknown node tag " + std::to_string(tagValue));
+
+        const NodeTag tag = static_cast<NodeTag>(tagValue);
+        switch (tag) {
+            case NodeTag::Addition:
+            case NodeTag::Multiplication:
+            case NodeTag::Exponentiation:
+            case NodeTag::Function: {
+                const uint64_t childCount = readVarint();
+                if (childCount != getChildCount(tag))
+                    throw serialization_error("Invalid child count in the encoded expression");
+
+                const std::string symbol = tag == NodeTag::Function ? std::string(readSymbol()) : "";
+
+                Expression* left = readNode();
+                Expression* right = nullptr;
+                if (childCount > 1) {
+                    try {
+                        right = readNode();
+                    }
+                    catch (...) {
+                        delete left;
+                        throw;
+                    }
+                }
+
+                return createNode(tag, symbol, 0, 0, left, right);
+            }
+            case NodeTag::Number: return createNode(tag, "", readDouble(), 0);
+            case NodeTag::Complex: {
+                const double real = readDouble();
+                return createNode(tag, "", real, readDouble());
+            }
+            case NodeTag::NamedConstant: {
+                const std::string symbol(readSymbol());
+                return createNode(tag, symbol, readDouble(), 0);
+            }
+            case NodeTag::Variable:
+            case NodeTag::Differential: return createNode(tag, std::string(readSymbol()), 0, 0);
+        }
+
+        throw serialization_error("Unknown node tag " + std::to_string(tagValue));
+    }
+
+    bool ExpressionReader::atEnd() const {
+        return position == end;
+    }
+
+    Expression* ExpressionReader::read() {
+        return readNode();
+    }
+#pragma endregion
+
+    std::string encodeExpression(const Expression* expr) {
+        std::ostringstream stream(std::ios::binary);
+
+        ExpressionWriter writer(stream);
+        writer.write(expr);
+
+        return stream.str();
+    }
+
+    Expression* decodeExpression(std::string_view data) {
+        ExpressionReader reader(data);
+        Expression* expr = reader.read();
+
+        if (!reader.atEnd()) {
+            delete expr;
+            throw serialization_error("Unexpected data after the encoded expression");
+        }
+
+        return expr;
+    }
+} // namespace cas::math
@@ -0,0 +1,71 @@
+#include "serialization/nodeTag.hpp"
+
+#include "expressions/expressions.hpp"
+
+namespace cas::math {
+    serialization_error::serialization_error(const std::string& message)
+        : std::runtime_error(message) {
+    }
+
+    NodeTag getNodeTag(const Expression* expr) {
+        switch (expr->getType()) {
+            case ExpressionTypes::Addition: return NodeTag::Addition;
+            case ExpressionTypes::Multiplication: return NodeTag::Multiplication;
+            case ExpressionTypes::Exponentiation: return NodeTag::Exponentiation;
+            case ExpressionTypes::Function: return NodeTag::Function;
+            case ExpressionTypes::Constant:
+                return dynamic_cast<const Complex*>(expr) != nullptr ? NodeTag::Complex : NodeTag::Number;
+            case ExpressionTypes::NamedConstant: return NodeTag::NamedConstant;
+            case ExpressionTypes::Variable: return NodeTag::Variable;
+            case ExpressionTypes::Differential: return NodeTag::Differential;
+        }
+
+        throw serialization_error("Cannot serialize " + expr->toString());
+    }
+
+    size_t getChildCount(NodeTag tag) {
+        switch (tag) {
+            case NodeTag::Addition:
+            case NodeTag::Multiplication:
+            case NodeTag::Exponentiation: return 2;
+            case NodeTag::Function: return 1;
+            default: return 0;
+        }
+    }
+
+    std::string getNodeSymbol(const Expression* expr) {
+        switch (expr->getType()) {
+            case ExpressionTypes::Function: return static_cast<const BaseFunction*>(expr)->name;
+            case ExpressionTypes::NamedConstant: return expr->toString();
+            case ExpressionTypes::Variable:
+            case ExpressionTypes::Differential: return static_cast<const Variable*>(expr)->getSymbol();
+            default: return "";
+        }
+    }
+
+    Expression* createNode(NodeTag tag, const std::string& symbol, double real, double imaginary, Expression* left, Expression* right) {
+        switch (tag) {
+            case NodeTag::Addition: return new Addition(left, right);
+            case NodeTag::Multiplication: return new Multiplication(left, right);
+            case NodeTag::Exponentiation: return new Exponentiation(left, right);
+            case NodeTag::Function: return createFunction(symbol, left);
+            case NodeTag::Number: return new Number(real);
+            case NodeTag::Complex: return new Complex(real, imaginary);
+            case NodeTag::NamedConstant:
+                if (symbol == "e")
+                    return new E();
+                if (symbol == "pi")
+                    return new Pi();
+                if (symbol == "i")
+                    return new I();
+
+                return new NamedConstant(symbol, real);
+            case NodeTag::Variable: return new Variable(symbol);
+            case NodeTag::Differential: return new Differential(symbol);
+        }
+
+        delete left;
+        delete right;
+        throw serialization_error("Unknown node tag " + std::to_string(static_cast<int>(tag)));
+    }
+} // namespace cas::math
@@ -0,0 +1,289 @@
+#include "serialization/snapshot.hpp"
+
+#include "expressions/expressions.hpp"
+#include "parallel/cancellation.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+
+#if !WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cas::math {
+    namespace {
+        constexpr char magic[4] = {'C', 'A', 'S', 'S'};
+        constexpr uint32_t noIndex = std::numeric_limits<uint32_t>::max();
+
+        inline size_t combine(size_t seed, size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+        }
+
+        inline bool hasSymbol(NodeTag tag) {
+            return tag == NodeTag::Function || tag == NodeTag::NamedConstant || tag == NodeTag::Variable || tag == NodeTag::Differential;
+        }
+    } // namespace
+
+#pragma region SnapshotWriter
+    size_t SnapshotWriter::NodeHash::operator()(const SnapshotNode& node) const {
+        size_t hash = static_cast<size_t>(node.tag);
+        hash = combine(hash, node.symbol);
+        hash = combine(hash, node.children[0]);
+        hash = combine(hash, node.children[1]);
+        hash = combine(hash, std::hash<double>{}(node.real));
+        return combine(hash, std::hash<double>{}(node.imaginary));
+    }
+
+    bool SnapshotWriter::NodeEqual::operator()(const SnapshotNode& lhs, const SnapshotNode& rhs) const {
+        // the nodes are compared bitwise, so 0 and -0 are different nodes
+        return std::memcmp(&lhs, &rhs, sizeof(SnapshotNode)) == 0;
+    }
+
+    uint32_t SnapshotWriter::addSymbol(const std::string& symbol) {
+        auto [it, inserted] = symbolIndices.try_emplace(symbol, static_cast<uint32_t>(symbols.size()));
+        if (inserted)
+            symbols.push_back(symbol);
+
+        return it->second;
+    }
+
+    uint32_t SnapshotWriter::addNode(const Expression* expr) {
+        checkCancellation();
+
+        SnapshotNode node;
+        std::memset(&node, 0, sizeof(SnapshotNode));
+
+        node.tag = getNodeTag(expr);
+        node.symbol = hasSymbol(node.tag) ? addSymbol(getNodeSymbol(expr)) : noIndex;
+        node.children[0] = noIndex;
+        node.children[1] = noIndex;
+
+        const std::vector<Expression*> children = expr->getChildren();
+        for (size_t i = 0; i < children.size() && i < 2; i++) {
+            node.children[i] = addNode(children[i]);
+        }
+
+        if (node.tag == NodeTag::Number || node.tag == NodeTag::NamedConstant) {
+            node.real = static_cast<const Number*>(expr)->realValue;
+        }
+        else if (node.tag == NodeTag::Complex) {
+            const Complex* complex = static_cast<const Complex*>(expr);
+            node.real = complex->realValue;
+            node.imaginary = complex->imaginary;
+        }
+
+        auto [it, inserted] = nodeIndices.try_emplace(node, static_cast<uint32_t>(nodes.size()));
+        if (inserted) {
+            if (nodes.size() == noIndex)
+                throw serialization_error("The snapshot contains too many nodes");
+
+            nodes.push_back(node);
+        }
+
+        return it->second;
+    }
+
+    void SnapshotWriter::add(const std::string& name, const Expression* expr) {
+        const uint32_t node = addNode(expr);
+        roots.push_back(SnapshotRoot{addSymbol(name), node});
+    }
+
+    void SnapshotWriter::write(const std::string& path) const {
+        std::vector<uint32_t> offsets;
+        offsets.reserve(symbols.size() + 1);
+
+        uint64_t symbolBytes = 0;
+        for (const std::string& symbol : symbols) {
+            offsets.push_back(static_cast<uint32_t>(symbolBytes));
+            symbolBytes += symbol.size();
+        }
+        offsets.push_back(static_cast<uint32_t>(symbolBytes));
+
+        if (symbolBytes > noIndex)
+            throw serialization_error("The symbols of the snapshot are too large");
+
+        SnapshotHeader header;
+        std::memset(&header, 0, sizeof(SnapshotHeader));
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.version = version;
+        header.nodeCount = static_cast<uint32_t>(nodes.size());
+        header.rootCount = static_cast<uint32_t>(roots.size());
+        header.symbolCount = static_cast<uint32_t>(symbols.size());
+        header.symbolBytes = symbolBytes;
+
+        const std::string temporaryPath = path + ".tmp";
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!file)
+                throw serialization_error("Cannot open " + temporaryPath);
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(SnapshotHeader));
+            file.write(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(SnapshotNode));
+            file.write(reinterpret_cast<const char*>(roots.data()), roots.size() * sizeof(SnapshotRoot));
+            file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+            for (const std::string& symbol : symbols) {
+                file.write(symbol.data(), symbol.size());
+            }
+
+            if (!file.flush())
+                throw serialization_error("Cannot write " + temporaryPath);
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath, path, error);
+        if (error) {
+            std::filesystem::remove(temporaryPath, error);
+            throw serialization_error("Cannot write " + path);
+        }
+    }
+#pragma endregion
+
+#pragma region Snapshot
+    Snapshot::Snapshot(const std::string& path) {
+#if !WIN32
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            throw serialization_error("Cannot open " + path);
+
+        struct stat status;
+        if (fstat(file, &status) != 0) {
+            close(file);
+            throw serialization_error("Cannot open " + path);
+        }
+
+        size = static_cast<size_t>(status.st_size);
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+            if (mapping != MAP_FAILED)
+                data = static_cast<const char*>(mapping);
+        }
+        close(file);
+#endif
+
+        if (data == nullptr) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                throw serialization_error("Cannot open " + path);
+
+            buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+        }
+
+        try {
+            validate();
+        }
+        catch (...) {
+#if !WIN32
+            if (buffer.empty() && data != nullptr)
+                munmap(const_cast<char*>(data), size);
+#endif
+            throw;
+        }
+    }
+
+    Snapshot::~Snapshot() {
+#if !WIN32
+        if (buffer.empty() && data != nullptr)
+            munmap(const_cast<char*>(data), size);
+#endif
+    }
+
+    void Snapshot::validate() {
+        if (size < sizeof(SnapshotHeader))
+            throw serialization_error("The file is not a snapshot");
+
+        header = reinterpret_cast<const SnapshotHeader*>(data);
+        if (std::memcmp(header->magic, magic, sizeof(magic)) != 0)
+            throw serialization_error("The file is not a snapshot");
+        if (header->version != SnapshotWriter::version)
+            throw serialization_error("Unsupported snapshot version " + std::to_string(header->version));
+
+        const size_t nodesOffset = sizeof(SnapshotHeader);
+        const size_t rootsOffset = nodesOffset + static_cast<size_t>(header->nodeCount) * sizeof(SnapshotNode);
+        const size_t offsetsOffset = rootsOffset + static_cast<size_t>(header->rootCount) * sizeof(SnapshotRoot);
+        const size_t symbolsOffset = offsetsOffset + (static_cast<size_t>(header->symbolCount) + 1) * sizeof(uint32_t);
+
+        if (symbolsOffset + header->symbolBytes != size)
+            throw serialization_error("The snapshot is truncated");
+
+        nodes = reinterpret_cast<const SnapshotNode*>(data + nodesOffset);
+        roots = reinterpret_cast<const SnapshotRoot*>(data + rootsOffset);
+        symbolOffsets = reinterpret_cast<const uint32_t*>(data + offsetsOffset);
+        symbolData = data + symbolsOffset;
+
+        for (uint32_t i = 0; i < header->symbolCount; i++) {
+            if (symbolOffsets[i] > symbolOffsets[i + 1])
+                throw serialization_error("The symbol table of the snapshot is corrupt");
+        }
+        if (symbolOffsets[header->symbolCount] != header->symbolBytes)
+            throw serialization_error("The symbol table of the snapshot is corrupt");
+
+        // children have smaller indices than their parents, so the expressions can not contain cycles
+        for (uint32_t i = 0; i < header->nodeCount; i++) {
+            const SnapshotNode& node = nodes[i];
+            if (static_cast<uint8_t>(node.tag) > static_cast<uint8_t>(NodeTag::Differential))
+                throw serialization_error("The node table of the snapshot is corrupt");
+            if (hasSymbol(node.tag) && node.symbol >= header->symbolCount)
+                throw serialization_error("The node table of the snapshot is corrupt");
+
+            for (size_t child = 0; child < getChildCount(node.tag); child++) {
+                if (node.children[child] >= i)
+                    throw serialization_error("The node table of the snapshot is corrupt");
+            }
+        }
+
+        for (uint32_t i = 0; i < header->rootCount; i++) {
+            if (roots[i].name >= header->symbolCount || roots[i].node >= header->nodeCount)
+                throw serialization_error("The roots of the snapshot are corrupt");
+        }
+    }
+
+    std::string_view Snapshot::getSymbol(uint32_t index) const {
+        return std::string_view(symbolData + symbolOffsets[index], symbolOffsets[index + 1] - symbolOffsets[index]);
+    }
+
+    Expression* Snapshot::createExpression(uint32_t index) const {
+        checkCancellation();
+
+        const SnapshotNode& node = nodes[index];
+        const std::string symbol = hasSymbol(node.tag) ? std::string(getSymbol(node.symbol)) : "";
+
+        Expression* left = nullptr;
+        Expression* right = nullptr;
+        const size_t childCount = getChildCount(node.tag);
+
+        try {
+            if (childCount > 0)
+                left = createExpression(node.children[0]);
+            if (childCount > 1)
+                right = createExpression(node.children[1]);
+        }
+        catch (...) {
+            delete left;
+            throw;
+        }
+
+        return createNode(node.tag, symbol, node.real, node.imaginary, left, right);
+    }
+
+    size_t Snapshot::getRootCount() const {
+        return header->rootCount;
+    }
+
+    std::string_view Snapshot::getName(size_t root) const {
+        return getSymbol(roots[root].name);
+    }
+
+    Expression* Snapshot::load(size_t root) const {
+        return createExpression(roots[root].node);
+    }
+#pragma endregion
+} // namespace cas::math
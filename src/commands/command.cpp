@@ -1,22 +1,188 @@
 #include "commands/command.hpp"
 
+#include "io/ioStream.hpp"
+#include "io/parseCache.hpp"
 #include "io/parser.hpp"
+#include "io/variableGraph.hpp"
 
 #include <mathlib/mathlib.hpp>
 
+#include <cmath>
+
 namespace cas::commands {
+    namespace {
+        // the variables of the executing engine are replaced by their values
+        Expression* parseExpression(const std::string& str) {
+            VariableGraph* variables = VariableGraph::getCurrent();
+            if (variables == nullptr)
+                return io::ParseCache::shared().parseCopy(str);
+
+            const FrozenExpression expr = io::ParseCache::shared().parse(str);
+            return variables->referencesVariables(expr.get()) ? variables->substitute(expr.get()) : expr.thaw();
+        }
+
+        std::string trim(const std::string& str) {
+            const size_t begin = str.find_first_not_of(" \t");
+            if (begin == std::string::npos)
+                return "";
+
+            const size_t end = str.find_last_not_of(" \t");
+            return str.substr(begin, end - begin + 1);
+        }
+
+        bool isList(const std::string& str) {
+            return str.size() >= 2 && str.front() == '[' && str.back() == ']';
+        }
+
+        // a list is written as [a, b, ...], a single value is treated as a list with one element
+        std::vector<std::string> getListElements(const std::string& argStr) {
+            const std::string str = trim(argStr);
+            if (!isList(str))
+                return {str};
+
+            std::vector<std::string> elements;
+            for (const std::string& element : io::IOStream::splitArguments(str.substr(1, str.size() - 2))) {
+                elements.push_back(trim(element));
+            }
+
+            return elements;
+        }
+
+        std::vector<double> parseNumbers(const std::string& argStr) {
+            std::vector<double> values;
+
+            for (const std::string& element : getListElements(argStr)) {
+                Expression* expr = parseExpression(element);
+                try {
+                    values.push_back(expr->getValue().realValue);
+                }
+                catch (...) {
+                    delete expr;
+                    throw;
+                }
+                delete expr;
+            }
+
+            return values;
+        }
+    } // namespace
+
     template<>
     cas::math::Expression* parseArg(const std::string& argStr) {
-        return cas::io::Parser::parse(argStr);
+        return parseExpression(argStr);
+    }
+
+    // the parsed tree is shared with the parse cache, it is only copied if the variables of the engine are substituted
+    template<>
+    cas::math::ExprRef parseArg(const std::string& argStr) {
+        const FrozenExpression expr = io::ParseCache::shared().parse(argStr);
+
+        VariableGraph* variables = VariableGraph::getCurrent();
+        if (variables != nullptr && variables->referencesVariables(expr.get()))
+            return ExprRef(variables->substitute(expr.get()));
+
+        return ExprRef(expr);
+    }
+
+    // the variables of the engine are not substituted, the command decides which of them are replaced
+    template<>
+    cas::math::FrozenExpression parseArg(const std::string& argStr) {
+        return io::ParseCache::shared().parse(argStr);
     }
 
     template<>
     cas::math::Variable* parseArg(const std::string& argStr) {
-        return new Variable(argStr);
+        return new Variable(trim(argStr));
     }
 
     template<>
     cas::math::VariableSymbol parseArg(const std::string& argStr) {
-        return argStr;
+        return trim(argStr);
+    }
+
+    template<>
+    std::vector<cas::math::Expression*> parseArg(const std::string& argStr) {
+        std::vector<Expression*> expressions;
+
+        try {
+            for (const std::string& element : getListElements(argStr)) {
+                // equations lhs=rhs are stored as lhs-rhs
+                const size_t pos = element.find('=');
+                if (pos == std::string::npos) {
+                    expressions.push_back(parseExpression(element));
+                    continue;
+                }
+
+                Expression* lhs = parseExpression(element.substr(0, pos));
+                Expression* rhs;
+                try {
+                    rhs = parseExpression(element.substr(pos + 1));
+                }
+                catch (...) {
+                    delete lhs;
+                    throw;
+                }
+                expressions.push_back(new Addition(lhs, new Multiplication(new Number(-1), rhs)));
+            }
+        }
+        catch (...) {
+            for (Expression* expr : expressions) {
+                delete expr;
+            }
+            throw;
+        }
+
+        return expressions;
+    }
+
+    template<>
+    std::vector<cas::math::Variable> parseArg(const std::string& argStr) {
+        std::vector<Variable> variables;
+
+        for (const std::string& element : getListElements(argStr)) {
+            variables.emplace_back(element);
+        }
+
+        return variables;
+    }
+
+    template<>
+    std::vector<std::vector<double>> parseArg(const std::string& argStr) {
+        std::vector<std::string> elements = getListElements(argStr);
+
+        // a list of lists contains several points, otherwise there is only one
+        if (!isList(elements.front()))
+            return {parseNumbers(argStr)};
+
+        std::vector<std::vector<double>> points;
+        for (const std::string& element : elements) {
+            points.push_back(parseNumbers(element));
+        }
+
+        return points;
+    }
+
+    // the range of a sweep is written as var=begin:end:count
+    template<>
+    cas::math::SweepAxis parseArg(const std::string& argStr) {
+        const size_t assignment = argStr.find('=');
+        if (assignment == std::string::npos)
+            throw std::runtime_error("The range \"" + trim(argStr) + "\" has to be written as var=begin:end:count");
+
+        const std::string symbol = trim(argStr.substr(0, assignment));
+        const std::string range = argStr.substr(assignment + 1);
+
+        const size_t firstColon = range.find(':');
+        const size_t secondColon = firstColon == std::string::npos ? std::string::npos : range.find(':', firstColon + 1);
+        if (symbol.empty() || secondColon == std::string::npos)
+            throw std::runtime_error("The range \"" + trim(argStr) + "\" has to be written as var=begin:end:count");
+
+        const double begin = parseNumbers(range.substr(0, firstColon)).front();
+        const double end = parseNumbers(range.substr(firstColon + 1, secondColon - firstColon - 1)).front();
+        const double count = parseNumbers(range.substr(secondColon + 1)).front();
+        if (count < 1 || std::floor(count) != count)
+            throw std::runtime_error("The number of points of " + symbol + " has to be a positive integer");
+
+        return SweepAxis{Variable(symbol), begin, end, static_cast<size_t>(count)};
     }
-}
\ No newline at end of file
+}
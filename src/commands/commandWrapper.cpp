@@ -1,13 +1,136 @@
 #include "commands/commandWrapper.hpp"
 
 #include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/variableGraph.hpp"
+
+#include <algorithm>
+#include <sstream>
 
 namespace cas::commands {
+    namespace {
+        std::string trim(const std::string& str) {
+            const size_t begin = str.find_first_not_of(" \t\r\n");
+            if (begin == std::string::npos)
+                return "";
+
+            const size_t end = str.find_last_not_of(" \t\r\n");
+            return str.substr(begin, end - begin + 1);
+        }
+
+        // true if the whole argument is one list, [a]*2 is not a list
+        bool isList(const std::string& arg) {
+            if (arg.size() < 2 || arg.front() != '[' || arg.back() != ']')
+                return false;
+
+            int bracketCounter = 0;
+            for (size_t i = 0; i < arg.size() - 1; i++) {
+                if (arg[i] == '[')
+                    bracketCounter++;
+                else if (arg[i] == ']')
+                    bracketCounter--;
+
+                if (bracketCounter == 0)
+                    return false;
+            }
+
+            return true;
+        }
+    } // namespace
+
     void CommandWrapper::saveAns(Engine* engine, Expression* expr) {
+        std::lock_guard<std::mutex> lock(engine->ansMutex);
         if (engine->ans != nullptr) {
             delete engine->ans;
         }
 
         engine->ans = expr;
     }
-} // namespace cas::commands
\ No newline at end of file
+
+    ResultCache* CommandWrapper::getResultCache(Engine* engine) {
+        return engine->resultCache.isEnabled() ? &engine->resultCache : nullptr;
+    }
+
+    std::vector<std::string> CommandWrapper::normalizeArguments(const std::vector<std::string>& argV) {
+        std::vector<std::string> args;
+        args.reserve(argV.size());
+
+        for (const std::string& arg : argV) {
+            args.push_back(trim(arg));
+        }
+
+        return args;
+    }
+
+    std::optional<std::vector<std::vector<std::string>>> CommandWrapper::expandBatch(const std::vector<std::string>& argV,
+                                                                                      const std::vector<bool>& batchArguments) {
+        std::vector<std::vector<std::string>> elements(argV.size());
+        std::optional<size_t> count;
+
+        for (size_t i = 0; i < argV.size() && i < batchArguments.size(); i++) {
+            const std::string& arg = argV[i];
+            if (!batchArguments[i] || !isList(arg))
+                continue;
+
+            // splitting [] gives one empty element
+            const std::string content = arg.substr(1, arg.size() - 2);
+            if (!trim(content).empty())
+                elements[i] = io::IOStream::splitArguments(content);
+
+            if (count && elements[i].size() != *count)
+                throw std::runtime_error("All lists of a command must have the same length");
+
+            count = elements[i].size();
+        }
+
+        if (!count)
+            return std::nullopt;
+
+        std::vector<std::vector<std::string>> batch(*count, argV);
+        for (size_t i = 0; i < elements.size(); i++) {
+            for (size_t j = 0; j < elements[i].size(); j++) {
+                batch[j][i] = trim(elements[i][j]);
+            }
+        }
+
+        return batch;
+    }
+
+    void CommandWrapper::runBatch(size_t count, const std::function<void(size_t)>& body) {
+        ThreadPool& pool = ThreadPool::shared();
+        const size_t grainSize = std::max<size_t>(1, count / (8 * pool.getThreadCount()));
+
+        // the variables are only known to the thread of the command
+        VariableGraph* variables = VariableGraph::getCurrent();
+        pool.parallelFor(0, count, [&](size_t begin, size_t end) {
+            VariableScope variableScope(variables);
+
+            for (size_t i = begin; i < end; i++) {
+                body(i);
+            }
+        }, grainSize);
+    }
+
+    void CommandWrapper::printExpressionList(const std::vector<std::unique_ptr<Expression>>& expressions) {
+        std::stringstream ss;
+        ss << "[";
+        for (size_t i = 0; i < expressions.size(); i++) {
+            ss << (i > 0 ? ", " : "") << expressions[i]->toString();
+        }
+        ss << "]";
+
+        io::IOStream::writeLine(ss.str());
+    }
+
+    void CommandWrapper::printElementOutputs(size_t count, const std::function<void(size_t)>& printElement) {
+        if (count == 0) {
+            io::IOStream::writeLine("[]");
+            return;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            io::IOStream::writeLine("Element " + std::to_string(i + 1) + ":");
+            printElement(i);
+        }
+    }
+} // namespace cas::commands
@@ -1,5 +1,8 @@
 #include "io/engine.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <future>
 #include <iostream>
 #include <regex>
 #include <sstream>
@@ -9,67 +12,295 @@
 #include "io/parser.hpp"
 
 namespace cas {
+    namespace {
+        // time a cancelled command has to reach its next cancellation point
+        constexpr std::chrono::milliseconds cancellationGracePeriod(1000);
+    } // namespace
+
     Engine::Engine() {
         setupCommands();
     }
 
-    void Engine::run() {
-        running = true;
+    Engine::~Engine() {
+        exitIfAbandoned();
 
-        Command<Expression*, VariableSymbol, Expression*> setVariableCommand = Command<Expression*, VariableSymbol, Expression*>(
-            [](cas::Engine* engine, VariableSymbol symbol, Expression* expr) {
-                // No need of this part. The expression should be stored in the ans pointer. So it gets deleted automatically
-                // if (engine->vars.contains(symbol)) {
-                //    delete engine->vars[symbol];
-                // }
+        delete ans;
+    }
 
-                engine->vars[symbol] = expr->copy();
-                return engine->vars[symbol];
-            });
+    void Engine::handleVariableInput(const std::string& input) {
+        if (input.contains('=')) {
+            size_t splitPosition = input.find('=');
 
-        Command<Expression*, VariableSymbol> getVariableCommand = Command<Expression*, VariableSymbol>(
-            [](Engine* engine, VariableSymbol symbol) {
-                return engine->vars.at(symbol)->copy();
-            });
+            const VariableSymbol symbol = input.substr(0, splitPosition);
+            const std::string& exprStr = input.substr(splitPosition + 1);
 
-        Command<Expression*> ansCommand = Command<Expression*>(
-            [](Engine* engine) {
-                return engine->ans->copy();
-            });
+            commands.at("set").executeCommand(this, {symbol, exprStr});
+        }
+        else if (variables.contains(input)) {
+            commands.at("get").executeCommand(this, {input});
+        }
+        else {
+            throw std::runtime_error("Command \"" + input + "\" not found!");
+        }
+    }
 
-        addCommand("set", setVariableCommand, Callbacks::printExpressionCallback);
-        addCommand("get", getVariableCommand, Callbacks::printExpressionCallback);
-        addCommand("ans", ansCommand, Callbacks::printExpressionCallback);
+    void Engine::executeCommand(const io::IOStream::Command& command, const CancellationToken& token) {
+        CancellationScope cancellationScope(token);
 
-        while (running) {
-            io::IOStream::Command command = io::IOStream::readCommand();
+        ResourceBudget budget(getLimits());
+        BudgetScope budgetScope(&budget);
 
-            try {
-                commands.at(command.alias).executeCommand(this, command.args);
-            }
-            catch (const std::runtime_error& e) {
-                std::cout << e.what() << std::endl;
-                continue;
-            }
-            catch (const std::out_of_range& e) {
-                const std::string& input = command.alias;
-                if (input.contains('=')) {
-                    size_t splitPosition = input.find('=');
+        VariableScope variableScope(&variables);
 
-                    const VariableSymbol symbol = input.substr(0, splitPosition);
-                    const std::string& exprStr = input.substr(splitPosition + 1);
+        auto it = commands.find(command.alias);
+        if (it != commands.end()) {
+            it->second.executeCommand(this, command.args);
+        }
+        else {
+            handleVariableInput(command.alias);
+        }
+    }
 
-                    commands.at("set").executeCommand(this, {symbol, exprStr});
-                    continue;
+    bool Engine::execute(const io::IOStream::Command& command) {
+        const size_t commandNumber = ++commandCounter;
+
+        if (poisoned) {
+            io::IOStream::writeError("The session is closed because a cancelled command did not stop");
+            return false;
+        }
+
+        CancellationToken token;
+        std::list<CancellationToken>::iterator tokenPosition;
+        {
+            std::lock_guard<std::mutex> lock(tokenMutex);
+            tokenPosition = runningTokens.insert(runningTokens.end(), token);
+        }
+
+        bool succeeded = true;
+        bool timedOut = false;
+
+        try {
+            if (timeout.count() == 0) {
+                executeCommand(command, token);
+            }
+            else {
+                ThreadPool* pool = executor;
+                if (pool == nullptr) {
+                    std::call_once(executorCreated, [this]() { ownExecutor = std::make_unique<ThreadPool>(1); });
+                    pool = ownExecutor.get();
                 }
-                else if (vars.contains(input)) {
-                    commands["get"].executeCommand(this, {input});
-                    continue;
+
+                // the command writes to its own buffer, which is copied to the output of the calling thread when the
+                // command finishes. An abandoned command outlives the call and must not write to the output of the
+                // caller, e.g. the stream of a server session
+                const auto commandOutput = std::make_shared<std::stringstream>();
+                std::future<void> result = pool->submit([this, command, token, commandOutput]() {
+                    io::IOStream::setOutput(commandOutput.get());
+
+                    executeCommand(command, token);
+                });
+
+                if (result.wait_for(timeout) == std::future_status::timeout) {
+                    token.cancel();
+                    timedOut = true;
+
+                    // the command uses the state of the engine. If it does not stop in time, the engine is poisoned and
+                    // the command is abandoned instead of blocking the session forever
+                    if (result.wait_for(cancellationGracePeriod) == std::future_status::timeout) {
+                        {
+                            std::lock_guard<std::mutex> lock(tokenMutex);
+                            abandonedCommands.push_back(AbandonedCommand{command.alias, std::move(result)});
+                        }
+
+                        poisoned = true;
+                        running = false;
+                        throw std::runtime_error("The command timed out after " + std::to_string(timeout.count()) +
+                                                 " ms and did not stop, the session is closed");
+                    }
                 }
 
-                std::cout << "Command \"" << command.alias << "\" not found!" << std::endl;
-                continue;
+                std::ostream* output = io::IOStream::getOutput();
+                (output != nullptr ? *output : std::cout) << commandOutput->str();
+
+                result.get();
+            }
+        }
+        catch (const std::exception& e) {
+            std::string message = e.what();
+            if (timedOut && dynamic_cast<const operation_cancelled_error*>(&e) != nullptr)
+                message = "The command timed out after " + std::to_string(timeout.count()) + " ms";
+
+            if (batchMode)
+                io::IOStream::writeError("Error in command " + std::to_string(commandNumber) + " (" + command.alias + "): " + message);
+            else
+                io::IOStream::writeError(message);
+
+            succeeded = false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(tokenMutex);
+            runningTokens.erase(tokenPosition);
+        }
+
+        return succeeded;
+    }
+
+    bool Engine::isIndependent(const io::IOStream::Command& command) const {
+        auto it = commands.find(command.alias);
+        return it != commands.end() && it->second.isCached();
+    }
+
+    void Engine::setTimeout(std::chrono::milliseconds timeout) {
+        this->timeout = timeout;
+    }
+
+    std::chrono::milliseconds Engine::getTimeout() const {
+        return timeout;
+    }
+
+    void Engine::setExecutor(ThreadPool* executor) {
+        this->executor = executor;
+    }
+
+    void Engine::setLimits(const ResourceLimits& limits) {
+        std::lock_guard<std::mutex> lock(limitsMutex);
+        this->limits = limits;
+    }
+
+    ResourceLimits Engine::getLimits() const {
+        std::lock_guard<std::mutex> lock(limitsMutex);
+        return limits;
+    }
+
+    void Engine::setCacheCapacity(size_t bytes) {
+        resultCache.setCapacity(bytes);
+    }
+
+    ResultCache::Statistics Engine::getCacheStatistics() const {
+        return resultCache.getStatistics();
+    }
+
+    void Engine::setSpeculation(bool enabled) {
+        if (enabled && !speculator)
+            speculator = std::make_unique<Speculator>(this);
+        else if (!enabled)
+            speculator.reset();
+    }
+
+    bool Engine::isSpeculating() const {
+        return speculator != nullptr;
+    }
+
+    size_t Engine::saveSnapshot(const std::string& path) const {
+        SnapshotWriter writer;
+
+        // ans is stored with an empty name, which is not a valid variable symbol
+        // the definitions are stored, the values are computed again after loading
+        const std::vector<VariableSymbol> symbols = variables.getSymbols();
+        for (const VariableSymbol& symbol : symbols) {
+            std::unique_ptr<Expression> definition(variables.getDefinition(symbol));
+            writer.add(symbol, definition.get());
+        }
+
+        bool hasAns;
+        {
+            std::lock_guard<std::mutex> lock(ansMutex);
+            hasAns = ans != nullptr;
+            if (hasAns)
+                writer.add("", ans);
+        }
+
+        writer.write(path);
+        return symbols.size() + (hasAns ? 1 : 0);
+    }
+
+    size_t Engine::loadSnapshot(const std::string& path) {
+        Snapshot snapshot(path);
+
+        // the engine is only changed if all expressions could be loaded and defined
+        std::vector<std::pair<VariableSymbol, Expression*>> definitions;
+        std::unique_ptr<Expression> loadedAns;
+        try {
+            for (size_t i = 0; i < snapshot.getRootCount(); i++) {
+                if (snapshot.getName(i).empty())
+                    loadedAns.reset(snapshot.load(i));
+                else
+                    definitions.emplace_back(snapshot.getName(i), snapshot.load(i));
+            }
+        }
+        catch (...) {
+            for (auto& [name, expr] : definitions) {
+                delete expr;
+            }
+            throw;
+        }
+
+        // checks all definitions before any of them is applied
+        const size_t count = definitions.size() + (loadedAns ? 1 : 0);
+        variables.defineAll(definitions);
+
+        if (loadedAns) {
+            std::lock_guard<std::mutex> lock(ansMutex);
+            delete ans;
+            ans = loadedAns.release();
+        }
+
+        return count;
+    }
+
+    void Engine::cancel() {
+        std::lock_guard<std::mutex> lock(tokenMutex);
+        for (const CancellationToken& token : runningTokens) {
+            token.cancel();
+        }
+    }
+
+    bool Engine::isPoisoned() const {
+        return poisoned;
+    }
+
+    void Engine::exitIfAbandoned() {
+        {
+            std::lock_guard<std::mutex> lock(tokenMutex);
+            std::vector<std::string> running;
+            for (const AbandonedCommand& abandoned : abandonedCommands) {
+                if (abandoned.result.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+                    running.push_back(abandoned.alias);
+            }
+
+            if (running.empty())
+                return;
+
+            for (const std::string& alias : running) {
+                std::cerr << "The cancelled command " << alias << " did not stop, exiting" << std::endl;
             }
         }
+
+        // the destructors can not run while the command uses the engine, but the output and the log are written
+        io::IOStream::flush();
+        std::_Exit(EXIT_FAILURE);
+    }
+
+    void Engine::setBatchMode(bool enabled) {
+        batchMode = enabled;
+    }
+
+    bool Engine::isRunning() const {
+        return running;
+    }
+
+    int Engine::run() {
+        running = true;
+        size_t failedCommands = 0;
+
+        io::IOStream::Command command;
+        while (running && io::IOStream::readCommand(command)) {
+            if (!execute(command))
+                failedCommands++;
+        }
+
+        io::IOStream::flush();
+        return failedCommands == 0 ? 0 : 1;
     }
-} // namespace cas
\ No newline at end of file
+} // namespace cas
@@ -55,5 +55,73 @@ namespace cas {
             }
             io::IOStream::writeLine(ss.str());
         };
+
+        CommandCallback<std::vector<math::PolynomialRoot>> Engine::Callbacks::printRootsCallback = [](std::vector<math::PolynomialRoot> roots) {
+            if (roots.empty()) {
+                io::IOStream::writeLine("The polynomial has no roots");
+                return;
+            }
+
+            std::stringstream ss;
+            ss << std::setprecision(15);
+
+            for (size_t i = 0; i < roots.size(); i++) {
+                if (i > 0)
+                    ss << std::endl;
+
+                const math::Complex& value = roots[i].value;
+                ss << value.realValue;
+                if (value.imaginary > 0)
+                    ss << "+" << value.imaginary << "i";
+                else if (value.imaginary < 0)
+                    ss << value.imaginary << "i";
+
+                if (!roots[i].converged)
+                    ss << " (not converged)";
+            }
+
+            io::IOStream::writeLine(ss.str());
+        };
+
+        CommandCallback<std::vector<math::NewtonSolution>> Engine::Callbacks::printNewtonSolutionsCallback = [](std::vector<math::NewtonSolution> solutions) {
+            std::stringstream ss;
+            ss << std::setprecision(15);
+
+            const char separator = ' ';
+            const int symbolWidth = 10;
+
+            for (size_t i = 0; i < solutions.size(); i++) {
+                if (i > 0)
+                    ss << std::endl;
+
+                const math::NewtonSolution& solution = solutions[i];
+                ss << "Solution " << i + 1 << " (" << (solution.converged ? "converged" : solution.stalled ? "stalled" : "not converged") << " after " << solution.iterations
+                   << " iterations, residual " << solution.residual << ")" << std::endl;
+                ss << std::left << std::setw(symbolWidth) << std::setfill(separator) << "Variable"
+                   << " | "
+                   << "Value";
+
+                for (const auto& [var, value] : solution.values) {
+                    ss << std::endl;
+                    ss << std::left << std::setw(symbolWidth) << std::setfill(separator) << var << " | ";
+                    ss << value;
+                }
+            }
+
+            io::IOStream::writeLine(ss.str());
+        };
+
+        CommandCallback<math::IntegrationResult> Engine::Callbacks::printIntegrationResultCallback = [](math::IntegrationResult result) {
+            std::stringstream ss;
+            ss << std::setprecision(15) << result.value << std::endl;
+            ss << std::setprecision(3) << "Error estimate: " << result.error;
+            if (!result.converged)
+                ss << " (tolerance not reached)";
+
+            ss << std::endl
+               << "Evaluations: " << result.evaluations << ", subintervals: " << result.intervals;
+
+            io::IOStream::writeLine(ss.str());
+        };
 #pragma endregion
 }
\ No newline at end of file
@@ -1,10 +1,14 @@
 #include "io/engine.hpp"
 
 #include "commands/differentialCalculus.hpp"
+#include "commands/equationSolving.hpp"
+#include "commands/evaluation.hpp"
+#include "commands/integralCalculus.hpp"
 #include "commands/termManipulation.hpp"
 #include "commands/termMatching.hpp"
 
 #include "io/ioStream.hpp"
+#include "io/parseCache.hpp"
 #include <mathlib/mathlib.hpp>
 
 #include <iomanip>
@@ -22,6 +26,70 @@ namespace cas {
         });
         addCommand("exit", exitCommand, Callbacks::printStringCallback);
 
+        Command<std::string, Expression*> timeoutCommand = Command<std::string, Expression*>(
+            [](Engine* engine, Expression* seconds) {
+                const double value = seconds->getValue().realValue;
+                if (value < 0)
+                    throw std::runtime_error("The timeout has to be positive");
+
+                engine->setTimeout(std::chrono::milliseconds(static_cast<long long>(value * 1000)));
+                return value == 0 ? std::string("timeout disabled") : "timeout set to " + seconds->toString() + " s";
+            });
+        addCommand("timeout", timeoutCommand, Callbacks::printStringCallback);
+
+        Command<std::string, Expression*, Expression*, Expression*> limitsCommand = Command<std::string, Expression*, Expression*, Expression*>(
+            [](Engine* engine, Expression* nodes, Expression* bytes, Expression* depth) {
+                auto getLimit = [](Expression* expr) {
+                    const double value = expr->getValue().realValue;
+                    if (value < 0)
+                        throw std::runtime_error("The limits have to be positive");
+
+                    return static_cast<size_t>(value);
+                };
+
+                engine->setLimits(ResourceLimits{getLimit(nodes), getLimit(bytes), getLimit(depth)});
+                return "limits set to " + nodes->toString() + " nodes, " + bytes->toString() + " bytes, depth " + depth->toString();
+            });
+        addCommand("limits", limitsCommand, Callbacks::printStringCallback);
+
+        Command<std::string, Expression*> cacheSizeCommand = Command<std::string, Expression*>(
+            [](Engine* engine, Expression* bytes) {
+                const double value = bytes->getValue().realValue;
+                if (value < 0)
+                    throw std::runtime_error("The cache size has to be positive");
+
+                engine->setCacheCapacity(static_cast<size_t>(value));
+                return value == 0 ? std::string("cache disabled") : "cache size set to " + bytes->toString() + " bytes";
+            });
+        addCommand("cacheSize", cacheSizeCommand, Callbacks::printStringCallback);
+
+        Command<std::string> cacheStatsCommand = Command<std::string>(
+            [](Engine* engine) {
+                const ResultCache::Statistics statistics = engine->getCacheStatistics();
+                const size_t lookups = statistics.hits + statistics.misses;
+
+                std::stringstream ss;
+                ss << "entries: " << statistics.entries << ", bytes: " << statistics.bytes << " of " << statistics.capacity << std::endl;
+                ss << "hits: " << statistics.hits << ", misses: " << statistics.misses << ", evictions: " << statistics.evictions;
+                if (lookups > 0)
+                    ss << ", hit rate: " << std::fixed << std::setprecision(1) << 100.0 * statistics.hits / lookups << " %";
+
+                const io::ParseCache::Statistics parseStatistics = io::ParseCache::shared().getStatistics();
+                ss << std::endl;
+                ss << "parsed expressions: " << parseStatistics.entries << ", bytes: " << parseStatistics.bytes << " of " << parseStatistics.capacity
+                   << ", hits: " << parseStatistics.hits << ", misses: " << parseStatistics.misses;
+
+                return ss.str();
+            });
+        addCommand("cacheStats", cacheStatsCommand, Callbacks::printStringCallback);
+
+        Command<std::string, Expression*> speculateCommand = Command<std::string, Expression*>(
+            [](Engine* engine, Expression* enabled) {
+                engine->setSpeculation(enabled->getValue().realValue != 0);
+                return engine->isSpeculating() ? std::string("speculation enabled") : std::string("speculation disabled");
+            });
+        addCommand("speculate", speculateCommand, Callbacks::printStringCallback);
+
         Command<std::string> listVarsCommand = Command<std::string>(
             [](Engine* engine) {
                 std::stringstream ss;
@@ -33,22 +101,97 @@ namespace cas {
                    << " | "
                    << "Value";
 
-                for (const auto& [symbol, expr] : engine->vars) {
+                // the definition is only shown if it references other variables
+                for (const VariableSymbol& symbol : engine->variables.getSymbols()) {
+                    std::unique_ptr<Expression> definition(engine->variables.getDefinition(symbol));
+                    std::unique_ptr<Expression> value(engine->variables.getValue(symbol));
+
                     ss << std::endl;
                     ss << std::left << std::setw(symbolWidth) << std::setfill(separator) << symbol << " | ";
-                    ss << expr->toString();
+                    if (engine->variables.referencesVariables(definition.get()))
+                        ss << definition->toString() << " = ";
+                    ss << value->toString();
                 }
 
                 return ss.str();
             });
         addCommand("listVars", listVarsCommand, Callbacks::printStringCallback);
 
-        addCommand("D", commands::differentiate, Callbacks::printExpressionCallback);
-        addCommand("Df", commands::differential, Callbacks::printExpressionCallback);
-        addCommand("simplify", commands::simplify, Callbacks::printExpressionCallback);
-        addCommand("match", commands::matchCommand, Callbacks::printExpressionMatchCallback);
-        addCommand("matchRecurse", commands::matchRecurseCommand, Callbacks::printExpressionMatchCallback);
-        addCommand("matchAll", commands::matchAllCommand, Callbacks::printExpressionMatchesCallback);
-        addCommand("substitute", commands::substituteCommand, Callbacks::printExpressionCallback);
+        // the definition is parsed without substituting the variables, so it follows later changes of the referenced variables
+        Command<Expression*, VariableSymbol, VariableSymbol> setVariableCommand = Command<Expression*, VariableSymbol, VariableSymbol>(
+            [](Engine* engine, VariableSymbol symbol, VariableSymbol definition) {
+                engine->variables.define(symbol, io::ParseCache::shared().parseCopy(definition));
+                if (engine->speculator)
+                    engine->speculator->schedule(symbol);
+
+                return engine->variables.getValue(symbol);
+            });
+
+        Command<Expression*, VariableSymbol> getVariableCommand = Command<Expression*, VariableSymbol>(
+            [](Engine* engine, VariableSymbol symbol) {
+                return engine->variables.getValue(symbol);
+            });
+
+        Command<std::string, VariableSymbol> dependentsCommand = Command<std::string, VariableSymbol>(
+            [](Engine* engine, VariableSymbol symbol) {
+                if (!engine->variables.contains(symbol))
+                    throw std::runtime_error("Variable " + symbol + " is not defined");
+
+                std::stringstream ss;
+                const std::vector<VariableSymbol> dependents = engine->variables.getDependents(symbol);
+                if (dependents.empty())
+                    return "No variable depends on " + symbol;
+
+                for (size_t i = 0; i < dependents.size(); i++) {
+                    ss << (i > 0 ? ", " : "") << dependents[i];
+                }
+
+                return ss.str();
+            });
+        addCommand("dependents", dependentsCommand, Callbacks::printStringCallback);
+
+        Command<Expression*> ansCommand = Command<Expression*>(
+            [](Engine* engine) {
+                std::lock_guard<std::mutex> lock(engine->ansMutex);
+                if (engine->ans == nullptr)
+                    throw std::runtime_error("No result has been calculated yet");
+
+                return engine->ans->copy();
+            });
+
+        Command<std::string, VariableSymbol> saveCommand = Command<std::string, VariableSymbol>(
+            [](Engine* engine, VariableSymbol path) {
+                const size_t count = engine->saveSnapshot(path);
+                return "saved " + std::to_string(count) + " expressions to " + path;
+            });
+
+        Command<std::string, VariableSymbol> loadCommand = Command<std::string, VariableSymbol>(
+            [](Engine* engine, VariableSymbol path) {
+                const size_t count = engine->loadSnapshot(path);
+                return "loaded " + std::to_string(count) + " expressions from " + path;
+            });
+
+        addCommand("save", saveCommand, Callbacks::printStringCallback);
+        addCommand("load", loadCommand, Callbacks::printStringCallback);
+
+        addCommand("set", setVariableCommand, Callbacks::printExpressionCallback);
+        addCommand("get", getVariableCommand, Callbacks::printExpressionCallback);
+        addCommand("ans", ansCommand, Callbacks::printExpressionCallback);
+
+        addCommand("D", commands::differentiate, Callbacks::printExpressionCallback, true);
+        addCommand("Df", commands::differential, Callbacks::printExpressionCallback, true);
+        addCommand("jacobian", commands::jacobianCommand, Callbacks::printStringCallback, true);
+        addCommand("series", commands::series, Callbacks::printExpressionCallback, true);
+        addCommand("integrate", commands::integrate, Callbacks::printIntegrationResultCallback, true);
+        addCommand("simplify", commands::simplify, Callbacks::printExpressionCallback, true);
+        addCommand("cancel", commands::cancel, Callbacks::printExpressionCallback, true);
+        addCommand("gcd", commands::gcd, Callbacks::printExpressionCallback, true);
+        addCommand("match", commands::matchCommand, Callbacks::printExpressionMatchCallback, true);
+        addCommand("matchRecurse", commands::matchRecurseCommand, Callbacks::printExpressionMatchCallback, true);
+        addCommand("matchAll", commands::matchAllCommand, Callbacks::printExpressionMatchesCallback, true);
+        addCommand("substitute", commands::substituteCommand, Callbacks::printExpressionCallback, true);
+        addCommand("sweep", commands::sweepCommand, Callbacks::printStringCallback);
+        addCommand("roots", commands::roots, Callbacks::printRootsCallback, true);
+        addCommand("nsolve", commands::nsolve, Callbacks::printNewtonSolutionsCallback, true);
     }
 } // namespace cas
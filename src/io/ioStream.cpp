@@ -4,7 +4,10 @@
 #include <string>
 
 namespace cas::io {
-    std::ofstream IOStream::log = std::ofstream("commandLog.log");
+    std::istream* IOStream::input = &std::cin;
+    thread_local std::ostream* IOStream::output = nullptr;
+    std::unique_ptr<Logger> IOStream::logger;
+    bool IOStream::prompt = true;
 
     void IOStream::removeWhitespaces(std::string& str) {
         for (auto it = str.begin(); it != str.end();) {
@@ -17,39 +20,42 @@ namespace cas::io {
         }
     }
 
-    IOStream::Command IOStream::readCommand() {
-        write(">");
+    bool IOStream::readCommand(Command& command) {
+        std::string text;
 
-        std::string input = readLine(';');
+        do {
+            if (!*input)
+                return false;
 
+            if (prompt)
+                write(">");
+
+            text = readLine(';');
+        } while (isEmptyCommand(text));
+
+        command = parseCommand(text);
+        return true;
+    }
+
+    IOStream::Command IOStream::parseCommand(const std::string& text) {
         std::string alias;
         std::vector<std::string> argV;
 
-        size_t bracketPosition = input.find('[');
+        size_t bracketPosition = text.find('[');
         if (bracketPosition != std::string::npos) {
             // read alias
-            alias = input.substr(0, bracketPosition);
+            alias = text.substr(0, bracketPosition);
             removeWhitespaces(alias);
 
             // read arguments
-            size_t bracketEnd = input.find_last_of(']');
-            std::string args = input.substr(bracketPosition + 1, bracketEnd - bracketPosition - 1);
-
-            // split argument string
-            size_t current = 0;
-            size_t next = args.find(',');
-            while (next != std::string::npos) {
-                argV.push_back(args.substr(current, next - current));
+            size_t bracketEnd = text.find_last_of(']');
+            std::string args = text.substr(bracketPosition + 1, bracketEnd - bracketPosition - 1);
 
-                current = next + 1;
-                next = args.find(',', current);
-            }
-
-            // add last argument
-            argV.push_back(args.substr(current));
+            argV = splitArguments(args);
         }
         else {
-            alias = input;
+            alias = text;
+            removeWhitespaces(alias);
         }
 
         return Command{
@@ -57,21 +63,98 @@ namespace cas::io {
             argV};
     }
 
+    bool IOStream::isEmptyCommand(const std::string& text) {
+        return text.find_first_not_of(" \t\r\n") == std::string::npos;
+    }
+
+    std::vector<std::string> IOStream::splitArguments(const std::string& str) {
+        std::vector<std::string> parts;
+        int bracketCounter = 0;
+        size_t current = 0;
+
+        for (size_t i = 0; i < str.size(); i++) {
+            switch (str[i]) {
+                case '(':
+                case '[':
+                case '{': bracketCounter++; break;
+                case ')':
+                case ']':
+                case '}': bracketCounter--; break;
+                case ',':
+                    if (bracketCounter == 0) {
+                        parts.push_back(str.substr(current, i - current));
+                        current = i + 1;
+                    }
+                    break;
+                default: break;
+            }
+        }
+
+        // add last argument
+        parts.push_back(str.substr(current));
+
+        return parts;
+    }
+
     std::string IOStream::readLine(char delimiter) {
         std::string line;
-        std::getline(std::cin, line, delimiter);
+        std::getline(*input, line, delimiter);
 
-        log << line << delimiter << std::endl;
+        writeLog(line, delimiter == '\n' ? "\n" : std::string{delimiter, '\n'});
         return line;
     }
 
     void IOStream::writeLine(const std::string& str) {
-        std::cout << str << std::endl;
-        log << str << std::endl;
+        (output != nullptr ? *output : std::cout) << str << '\n';
+        writeLog(str, "\n");
     }
 
     void IOStream::write(const std::string& str) {
-        std::cout << str;
-        log << str;
+        (output != nullptr ? *output : std::cout) << str;
+        writeLog(str);
+    }
+
+    void IOStream::writeError(const std::string& str) {
+        // in batch mode errors are reported separately from the results
+        std::ostream& stream = output != nullptr ? *output : (prompt ? std::cout : std::cerr);
+        stream << str << '\n';
+        writeLog(str, "\n", LogLevel::Error);
+    }
+
+    void IOStream::writeLog(const std::string& str, const std::string& suffix, LogLevel level) {
+        if (logger == nullptr || !logger->isEnabled(level))
+            return;
+
+        logger->log(level, str + suffix);
+    }
+
+    void IOStream::setInput(std::istream& stream) {
+        input = &stream;
+    }
+
+    void IOStream::setOutput(std::ostream* stream) {
+        output = stream;
+    }
+
+    std::ostream* IOStream::getOutput() {
+        return output;
+    }
+
+    void IOStream::setPrompt(bool enabled) {
+        prompt = enabled;
+    }
+
+    void IOStream::setLog(const LoggerOptions& options) {
+        logger.reset();
+
+        if (!options.path.empty())
+            logger = std::make_unique<Logger>(options);
+    }
+
+    void IOStream::flush() {
+        std::cout.flush();
+
+        if (logger != nullptr)
+            logger->flush();
     }
 } // namespace cas::io
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "io/logger.hpp"
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace cas::io {
+    Logger::Logger(const LoggerOptions& options)
+        : options(options), buffer(options.capacity) {
+        file.open(options.path, std::ios::trunc);
+        if (!file)
+            throw std::runtime_error("Cannot open the log file " + options.path);
+
+        worker = std::thread(&Logger::workerLoop, this);
+    }
+
+    Logger::~Logger() {
+        stopping = true;
+        wakeups++;
+        wakeups.notify_one();
+
+        worker.join();
+    }
+
+    bool Logger::isEnabled(LogLevel level) const {
+        return level >= options.level;
+    }
+
+    void Logger::log(LogLevel level, std::string&& record) {
+        if (!isEnabled(level))
+            return;
+
+        if (buffer.push(std::move(record))) {
+            accepted++;
+
+            wakeups++;
+            wakeups.notify_one();
+        }
+        else {
+            dropped++;
+        }
+    }
+
+    void Logger::flush() {
+        const size_t target = accepted.load();
+
+        size_t current = processed.load();
+        while (current < target) {
+            processed.wait(current);
+            current = processed.load();
+        }
+    }
+
+    void Logger::workerLoop() {
+        std::string record;
+
+        while (true) {
+            // read the counter and the flag before the buffer, so no record logged before the wait or the destructor is
+            // lost
+            const size_t seenWakeups = wakeups.load();
+            const bool stop = stopping.load();
+
+            size_t count = 0;
+            while (buffer.pop(record)) {
+                writeRecord(record);
+                count++;
+            }
+
+            const size_t droppedRecords = dropped.exchange(0);
+            if (droppedRecords > 0)
+                writeRecord("[" + std::to_string(droppedRecords) + " log records dropped]\n");
+
+            if (count > 0) {
+                // a single flush for all records of the batch
+                file.flush();
+
+                processed += count;
+                processed.notify_all();
+            }
+
+            if (stop)
+                break;
+
+            // sleeps until a record is pushed or the logger is destroyed
+            if (count == 0)
+                wakeups.wait(seenWakeups);
+        }
+    }
+
+    void Logger::writeRecord(const std::string& record) {
+        if (options.maxFileSize > 0 && fileSize + record.size() > options.maxFileSize && fileSize > 0)
+            rotate();
+
+        file << record;
+        fileSize += record.size();
+    }
+
+    void Logger::rotate() {
+        file.close();
+
+        std::error_code error;
+        if (options.maxFiles == 0) {
+            std::filesystem::remove(options.path, error);
+        }
+        else {
+            // path.1 is the newest rotated file
+            for (size_t i = options.maxFiles; i > 1; i--) {
+                std::filesystem::rename(options.path + "." + std::to_string(i - 1), options.path + "." + std::to_string(i), error);
+            }
+            std::filesystem::rename(options.path, options.path + ".1", error);
+        }
+
+        file.open(options.path, std::ios::trunc);
+        fileSize = 0;
+    }
+} // namespace cas::io
@@ -0,0 +1,86 @@
+#include "io/parseCache.hpp"
+
+#include "io/parser.hpp"
+
+namespace cas::io {
+    namespace {
+        // approximate size of an expression node including the allocation overhead
+        constexpr size_t nodeSize = sizeof(math::Multiplication) + 16;
+    } // namespace
+
+    ParseCache::ParseCache(size_t capacity)
+        : capacity(capacity) {
+    }
+
+    ParseCache& ParseCache::shared() {
+        static ParseCache cache;
+        return cache;
+    }
+
+    math::FrozenExpression ParseCache::parse(const std::string& text) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = index.find(text);
+            if (it != index.end()) {
+                hits++;
+
+                entries.splice(entries.begin(), entries, it->second);
+                return it->second->expr;
+            }
+
+            misses++;
+        }
+
+        // parse without holding the lock, other threads can use the cache in the meantime
+        math::FrozenExpression expr(Parser::parse(text));
+        const size_t size = sizeof(Entry) + 2 * text.size() + expr.getNodeCount() * nodeSize;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (size > capacity || index.contains(text))
+            return expr;
+
+        evict(capacity - size);
+
+        entries.push_front(Entry{text, expr, size});
+        index.emplace(text, entries.begin());
+        bytes += size;
+
+        return expr;
+    }
+
+    math::Expression* ParseCache::parseCopy(const std::string& text) {
+        return parse(text).thaw();
+    }
+
+    void ParseCache::evict(size_t capacity) {
+        while (bytes > capacity) {
+            const Entry& last = entries.back();
+
+            bytes -= last.bytes;
+            index.erase(last.text);
+            entries.pop_back();
+        }
+    }
+
+    void ParseCache::setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        this->capacity = capacity;
+        evict(capacity);
+    }
+
+    void ParseCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        entries.clear();
+        index.clear();
+        bytes = 0;
+    }
+
+    ParseCache::Statistics ParseCache::getStatistics() const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        return Statistics{hits, misses, entries.size(), bytes, capacity};
+    }
+} // namespace cas::io
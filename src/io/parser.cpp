@@ -1,6 +1,9 @@
 #include "io/parser.hpp"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <sstream>
 
 using namespace cas::math;
@@ -12,9 +15,81 @@ namespace std {
 } // namespace std
 
 namespace cas::io {
-    const std::regex Parser::numberRegex = std::regex("^-?\\d+");
+    namespace {
+        constexpr uint64_t repeatByte(uint8_t byte) {
+            return 0x0101010101010101ull * byte;
+        }
+
+        // true if a byte of the word equals the repeated byte of the pattern. Bytes following a matching byte can be
+        // reported wrongly, which only matters if no byte matches
+        inline bool containsByte(uint64_t word, uint64_t pattern) {
+            const uint64_t x = word ^ pattern;
+            return ((x - repeatByte(0x01)) & ~x & repeatByte(0x80)) != 0;
+        }
+
+        struct Summand {
+            size_t begin;
+            size_t end;
+            bool negative;
+        };
+
+        // the summands of the top level sum. Like in Parser::parseAddition the first character of every summand is no
+        // split point, a minus sign belongs to the following summand. Words of eight characters without brackets or
+        // signs are skipped at once
+        std::vector<Summand> splitSummands(const std::string& str) {
+            const char* data = str.data();
+            const size_t length = str.size();
+
+            std::vector<Summand> summands;
+            size_t begin = 0;
+            size_t firstSplit = 1;
+            bool negative = false;
+            int bracketCounter = 0;
+
+            size_t i = 0;
+            while (i < length) {
+                if (i + sizeof(uint64_t) <= length) {
+                    uint64_t word;
+                    std::memcpy(&word, data + i, sizeof(word));
+
+                    if (!containsByte(word, repeatByte('(')) && !containsByte(word, repeatByte(')')) && !containsByte(word, repeatByte('+')) &&
+                        !containsByte(word, repeatByte('-'))) {
+                        i += sizeof(uint64_t);
+                        continue;
+                    }
+                }
+
+                const size_t end = std::min(i + sizeof(uint64_t), length);
+                for (; i < end; i++) {
+                    const char character = data[i];
+
+                    if (character == '(') {
+                        bracketCounter++;
+                    }
+                    else if (character == ')') {
+                        bracketCounter--;
+                    }
+                    else if ((character == '+' || character == '-') && bracketCounter == 0 && i >= firstSplit) {
+                        summands.push_back({begin, i, negative});
+
+                        // after a minus the sign is the first character of the next summand
+                        begin = i + 1;
+                        negative = character == '-';
+                        firstSplit = negative ? i + 1 : i + 2;
+                    }
+                }
+            }
+
+            summands.push_back({begin, length, negative});
+            return summands;
+        }
+    } // namespace
+
+    const std::regex Parser::numberRegex = std::regex("^-?\\d+(\\.\\d+)?");
 
     Expression* Parser::parseAddition(const std::string& str) {
+        DepthGuard depthGuard;
+
         std::stringstream ss;
 
         // get first summand
@@ -49,13 +124,19 @@ namespace cas::io {
             right = parseAddition(rightStr);
         }
         else {
-            right = new Multiplication(new Number(-1), parseAddition(rightStr));
+            // the minus sign only belongs to the first summand of the right side
+            right = parseAddition("-" + rightStr);
         }
 
         return new Addition(left, right);
     }
 
     Expression* Parser::parseMultiplication(const std::string& str) {
+        DepthGuard depthGuard;
+
+        if (str.empty())
+            throw std::runtime_error("Missing operand");
+
         // negative sign
         if (str.front() == '-' && !std::regex_match(str, numberRegex)) {
             Expression* expr = parse(str.substr(1));
@@ -137,6 +218,8 @@ namespace cas::io {
     }
 
     Expression* Parser::parseExponentiation(const std::string& str) {
+        DepthGuard depthGuard;
+
         std::stringstream ss;
 
         // get first factor
@@ -170,6 +253,9 @@ namespace cas::io {
             if (std::regex_match(str, numberRegex)) {
                 return parseConstant(str);
             }
+            else if (str == "pi") {
+                return new Pi();
+            }
             else {
                 return parseFunction(str);
             }
@@ -221,44 +307,11 @@ namespace cas::io {
         const std::string& argument = getBracketContent(str, it);
         Expression* argumentExpr = parse(argument);
 
-        if (symbol == "sin") {
-            return new Sin(argumentExpr);
-        }
-        else if (symbol == "arcsin") {
-            return new Arcsin(argumentExpr);
-        }
-        else if (symbol == "cos") {
-            return new Cos(argumentExpr);
-        }
-        else if (symbol == "arccos") {
-            return new Arccos(argumentExpr);
-        }
-        else if (symbol == "tan") {
-            return new Tan(argumentExpr);
-        }
-        else if (symbol == "arctan") {
-            return new Arctan(argumentExpr);
-        }
-        else if (symbol == "sinh") {
-            return new Sinh(argumentExpr);
-        }
-        else if (symbol == "asinh") {
-            return new Asinh(argumentExpr);
-        }
-        else if (symbol == "cosh") {
-            return new Cosh(argumentExpr);
-        }
-        else if (symbol == "acosh") {
-            return new Acosh(argumentExpr);
-        }
-        else if (symbol == "ln") {
-            return new Ln(argumentExpr);
-        }
-        else if (symbol == "exp") {
+        if (symbol == "exp") {
             return new Exponentiation(new math::E(), argumentExpr);
         }
 
-        throw new std::runtime_error("Function " + symbol + " is not defined");
+        return createFunction(symbol, argumentExpr);
     }
 
     std::string Parser::getBracketContent(const std::string& str, int begin) {
@@ -299,6 +352,57 @@ namespace cas::io {
     }
 
     Expression* Parser::parse(const std::string& str) {
+        if (str.size() >= parallelThreshold)
+            return parseParallel(str);
+
         return parseAddition(str);
     }
+
+    Expression* Parser::parseParallel(const std::string& str) {
+        const std::vector<Summand> summands = splitSummands(str);
+        if (summands.size() == 1)
+            return parseMultiplication(str);
+
+        std::vector<Expression*> terms(summands.size(), nullptr);
+        std::vector<std::exception_ptr> errors(summands.size());
+
+        // a few chunks per thread, so the threads can balance summands of different length
+        ThreadPool& pool = ThreadPool::shared();
+        const size_t grainSize = std::max<size_t>(summands.size() / (8 * pool.getThreadCount()), 1);
+
+        pool.parallelFor(0, summands.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Summand& summand = summands[i];
+
+                // a cancellation is stored like a parse error, so the terms that were already parsed are deleted
+                try {
+                    checkCancellation();
+
+                    const std::string termStr = (summand.negative ? "-" : "") + str.substr(summand.begin, summand.end - summand.begin);
+                    terms[i] = parseMultiplication(termStr);
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        }, grainSize);
+
+        // the error of the first invalid summand is reported like by the sequential parser
+        for (size_t i = 0; i < summands.size(); i++) {
+            if (errors[i]) {
+                for (Expression* term : terms) {
+                    delete term;
+                }
+                std::rethrow_exception(errors[i]);
+            }
+        }
+
+        // the sequential parser nests the sums to the right
+        Expression* result = terms.back();
+        for (size_t i = terms.size() - 1; i-- > 0;) {
+            result = new Addition(terms[i], result);
+        }
+
+        return result;
+    }
 } // namespace cas::io
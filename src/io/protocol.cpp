@@ -0,0 +1,118 @@
+#include "io/protocol.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+namespace cas::io {
+    Protocol::Protocol(Engine& engine, std::istream& input, std::ostream& output, size_t workerCount)
+        : engine(engine), input(input), output(output), timeoutExecutor(workerCount + 1), workers(workerCount) {
+        engine.setExecutor(&timeoutExecutor);
+    }
+
+    Protocol::~Protocol() {
+        // the executor can not be stopped while an abandoned command runs on it
+        engine.exitIfAbandoned();
+        engine.setExecutor(nullptr);
+    }
+
+    int Protocol::run() {
+        std::string line;
+        while (engine.isRunning() && std::getline(input, line)) {
+            Request request;
+            if (!parseRequest(line, request))
+                continue;
+
+            if (!engine.isIndependent(request.command)) {
+                waitForRequests();
+                process(request);
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                runningRequests++;
+            }
+
+            workers.submit([this, request = std::move(request)]() {
+                process(request);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                runningRequests--;
+                requestFinished.notify_all();
+            });
+        }
+
+        waitForRequests();
+        return failedRequests == 0 ? 0 : 1;
+    }
+
+    bool Protocol::parseRequest(const std::string& line, Request& request) {
+        const size_t idBegin = line.find_first_not_of(" \t\r");
+        if (idBegin == std::string::npos)
+            return false;
+
+        const size_t idEnd = std::min(line.find_first_of(" \t\r", idBegin), line.size());
+        request.id = line.substr(idBegin, idEnd - idBegin);
+
+        // the terminating semicolon of the interactive mode is optional
+        std::string text = idEnd < line.size() ? line.substr(idEnd) : "";
+        const size_t textEnd = text.find_last_not_of(" \t\r;");
+        text.erase(textEnd == std::string::npos ? 0 : textEnd + 1);
+
+        if (IOStream::isEmptyCommand(text)) {
+            failedRequests++;
+            respond(request.id, false, "The request contains no command");
+            return false;
+        }
+
+        request.command = IOStream::parseCommand(text);
+        return true;
+    }
+
+    void Protocol::process(const Request& request) {
+        std::stringstream commandOutput;
+        std::ostream* previousOutput = IOStream::getOutput();
+        IOStream::setOutput(&commandOutput);
+
+        const bool succeeded = engine.execute(request.command);
+
+        IOStream::setOutput(previousOutput);
+
+        if (!succeeded)
+            failedRequests++;
+
+        std::string text = commandOutput.str();
+        if (!text.empty() && text.back() == '\n')
+            text.pop_back();
+
+        respond(request.id, succeeded, text);
+    }
+
+    void Protocol::respond(const std::string& id, bool succeeded, const std::string& text) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+
+        // every response is flushed, so the client can use it before the other requests are finished
+        output << id << (succeeded ? " ok " : " error ") << escape(text) << std::endl;
+    }
+
+    void Protocol::waitForRequests() {
+        std::unique_lock<std::mutex> lock(mutex);
+        requestFinished.wait(lock, [this]() { return runningRequests == 0; });
+    }
+
+    std::string Protocol::escape(const std::string& str) {
+        std::string escaped;
+        escaped.reserve(str.size());
+
+        for (char c : str) {
+            switch (c) {
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                default: escaped += c; break;
+            }
+        }
+
+        return escaped;
+    }
+} // namespace cas::io
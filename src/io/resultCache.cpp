@@ -0,0 +1,198 @@
+#include "io/resultCache.hpp"
+
+#include "io/parseCache.hpp"
+#include "io/variableGraph.hpp"
+
+namespace cas {
+    namespace {
+        // approximate size of an expression node including the allocation overhead
+        constexpr size_t nodeSize = sizeof(math::Multiplication) + 16;
+
+        inline size_t combine(size_t seed, size_t value) {
+            return seed ^ (value + 0x9e3779b97f4a7c15 + (seed << 6) + (seed >> 2));
+        }
+    } // namespace
+
+    bool ResultCache::Key::operator==(const Key& other) const {
+        if (hash != other.hash || alias != other.alias || texts != other.texts || expressions.size() != other.expressions.size())
+            return false;
+
+        for (size_t i = 0; i < expressions.size(); i++) {
+            if (!(expressions[i] == other.expressions[i]))
+                return false;
+        }
+
+        return true;
+    }
+
+    ResultCache::ResultCache(size_t capacity)
+        : capacity(capacity) {
+    }
+
+    ResultCache::Key ResultCache::makeKey(const std::string& alias, const std::vector<std::string>& args) {
+        Key key;
+        key.alias = alias;
+        key.hash = std::hash<std::string>{}(alias);
+
+        for (const std::string& arg : args) {
+            math::FrozenExpression expr;
+
+            // lists are not expressions
+            if (!arg.empty() && arg.front() != '[') {
+                try {
+                    expr = io::ParseCache::shared().parse(arg);
+
+                    // the key contains the values of the variables, so changing a variable does not return old results
+                    VariableGraph* variables = VariableGraph::getCurrent();
+                    if (variables != nullptr && variables->referencesVariables(expr.get()))
+                        expr = math::FrozenExpression(variables->substitute(expr.get()));
+                }
+                catch (const std::exception&) {
+                }
+            }
+
+            if (expr) {
+                key.texts.push_back("");
+                key.hash = combine(key.hash, expr.getHash());
+            }
+            else {
+                key.texts.push_back(arg);
+                key.hash = combine(key.hash, std::hash<std::string>{}(arg));
+            }
+
+            key.expressions.push_back(std::move(expr));
+        }
+
+        return key;
+    }
+
+    const std::any* ResultCache::lookup(const Key& key) {
+        auto [begin, end] = index.equal_range(key.hash);
+        for (auto it = begin; it != end; it++) {
+            if (it->second->key == key) {
+                hits++;
+
+                // move the entry to the front of the list
+                entries.splice(entries.begin(), entries, it->second);
+                return &it->second->value;
+            }
+        }
+
+        misses++;
+        return nullptr;
+    }
+
+    void ResultCache::store(Key&& key, std::any&& value, size_t size) {
+        if (size > capacity)
+            return;
+
+        // the result could have been stored by another thread in the meantime
+        auto [begin, end] = index.equal_range(key.hash);
+        for (auto it = begin; it != end; it++) {
+            if (it->second->key == key)
+                return;
+        }
+
+        while (bytes + size > capacity) {
+            evictLast();
+        }
+
+        const size_t hash = key.hash;
+        entries.push_front(Entry{std::move(key), std::move(value), size});
+        index.emplace(hash, entries.begin());
+        bytes += size;
+    }
+
+    bool ResultCache::contains(const Key& key) const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto [begin, end] = index.equal_range(key.hash);
+        for (auto it = begin; it != end; it++) {
+            if (it->second->key == key)
+                return true;
+        }
+
+        return false;
+    }
+
+    void ResultCache::evictLast() {
+        const Entry& last = entries.back();
+
+        auto [begin, end] = index.equal_range(last.key.hash);
+        for (auto it = begin; it != end; it++) {
+            if (&*it->second == &last) {
+                index.erase(it);
+                break;
+            }
+        }
+
+        bytes -= last.bytes;
+        evictions++;
+        entries.pop_back();
+    }
+
+    void ResultCache::setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->capacity = capacity;
+
+        while (bytes > capacity) {
+            evictLast();
+        }
+    }
+
+    bool ResultCache::isEnabled() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return capacity > 0;
+    }
+
+    void ResultCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        entries.clear();
+        index.clear();
+        bytes = 0;
+    }
+
+    ResultCache::Statistics ResultCache::getStatistics() const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        return Statistics{hits, misses, evictions, entries.size(), bytes, capacity};
+    }
+
+    size_t ResultCache::estimateSize(const Key& key) {
+        size_t size = sizeof(Entry) + key.alias.size();
+
+        for (size_t i = 0; i < key.texts.size(); i++) {
+            size += key.texts[i].size();
+            size += key.expressions[i].getNodeCount() * nodeSize;
+        }
+
+        return size;
+    }
+
+    size_t ResultCache::estimateSize(const std::string& value) {
+        return sizeof(value) + value.size();
+    }
+
+    size_t ResultCache::estimateSize(const math::FrozenExpression& value) {
+        return value.getNodeCount() * nodeSize;
+    }
+
+    size_t ResultCache::estimateSize(const math::ExpressionMatch& value) {
+        size_t size = sizeof(value);
+        for (const auto& [symbol, expr] : value.variables) {
+            size += symbol.size() + math::countNodes(expr) * nodeSize;
+        }
+
+        return size;
+    }
+
+    size_t ResultCache::estimateSize(const math::NewtonSolution& value) {
+        size_t size = sizeof(value);
+        for (const auto& [symbol, x] : value.values) {
+            size += sizeof(x) + symbol.size();
+        }
+
+        return size;
+    }
+} // namespace cas
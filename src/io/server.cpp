@@ -0,0 +1,292 @@
+#include "io/server.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#if !WIN32
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace cas::io {
+#if !WIN32
+    namespace {
+        std::atomic<bool> stopRequested = false;
+        int signalPipe = -1;
+
+        void handleSignal(int) {
+            stopRequested = true;
+
+            const char wakeup = 0;
+            [[maybe_unused]] ssize_t count = write(signalPipe, &wakeup, 1);
+        }
+    } // namespace
+
+    Server::Server(const std::string& path, size_t workerCount, std::chrono::milliseconds timeout, const ResourceLimits& limits,
+                   size_t cacheCapacity)
+        : path(path), timeout(timeout), limits(limits), cacheCapacity(cacheCapacity), timeoutExecutor(workerCount), workers(workerCount) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+            throw std::runtime_error("The socket path " + path + " is too long");
+
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        listenSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listenSocket < 0)
+            throw std::runtime_error("Cannot create socket: " + std::string(std::strerror(errno)));
+
+        // remove the socket of a previous run. Other files and sockets of running servers are never removed
+        struct stat status;
+        if (lstat(path.c_str(), &status) == 0) {
+            const int probe = S_ISSOCK(status.st_mode) ? socket(AF_UNIX, SOCK_STREAM, 0) : -1;
+            const bool stale = probe >= 0 && connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 && errno == ECONNREFUSED;
+            if (probe >= 0)
+                close(probe);
+
+            if (!stale) {
+                close(listenSocket);
+                throw std::runtime_error("Cannot listen on " + path + ": address in use");
+            }
+
+            unlink(path.c_str());
+        }
+
+        if (bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenSocket, SOMAXCONN) < 0) {
+            const std::string error = std::strerror(errno);
+            close(listenSocket);
+            throw std::runtime_error("Cannot listen on " + path + ": " + error);
+        }
+
+        if (pipe(wakeupPipe) < 0) {
+            close(listenSocket);
+            throw std::runtime_error("Cannot create pipe: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    Server::~Server() {
+        {
+            // wait for the running commands
+            std::unique_lock<std::mutex> lock(mutex);
+            for (auto& [socket, session] : sessions) {
+                session->pending.clear();
+                session->engine.cancel();
+            }
+
+            sessionIdle.wait(lock, [this]() {
+                return std::none_of(sessions.begin(), sessions.end(), [](const auto& entry) { return entry.second->busy; });
+            });
+        }
+
+        for (auto& [socket, session] : sessions) {
+            close(socket);
+
+            if (session->engine.isPoisoned())
+                abandonedSessions.push_back(std::move(session));
+        }
+
+        close(wakeupPipe[0]);
+        close(wakeupPipe[1]);
+        close(listenSocket);
+
+        // the path may have been replaced while the server was running
+        struct stat status;
+        if (lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+            unlink(path.c_str());
+
+        // the timeout executor can not be stopped while an abandoned command runs on it
+        for (const std::unique_ptr<Session>& session : abandonedSessions) {
+            session->engine.exitIfAbandoned();
+        }
+    }
+
+    void Server::run() {
+        signalPipe = wakeupPipe[1];
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        std::vector<pollfd> descriptors;
+
+        while (!stopRequested) {
+            closeFinishedSessions();
+
+            descriptors.clear();
+            descriptors.push_back({listenSocket, POLLIN, 0});
+            descriptors.push_back({wakeupPipe[0], POLLIN, 0});
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (const auto& [socket, session] : sessions) {
+                    if (!session->closing)
+                        descriptors.push_back({socket, POLLIN, 0});
+                }
+            }
+
+            if (poll(descriptors.data(), descriptors.size(), -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                throw std::runtime_error("poll failed: " + std::string(std::strerror(errno)));
+            }
+
+            if (descriptors[1].revents & POLLIN) {
+                char buffer[64];
+                [[maybe_unused]] ssize_t count = read(wakeupPipe[0], buffer, sizeof(buffer));
+            }
+
+            for (size_t i = 2; i < descriptors.size(); i++) {
+                if (descriptors[i].revents == 0)
+                    continue;
+
+                // sessions are only removed by this thread
+                receive(*sessions.at(descriptors[i].fd));
+            }
+
+            if (descriptors[0].revents & POLLIN)
+                acceptConnection();
+        }
+    }
+
+    void Server::acceptConnection() {
+        const int socket = accept(listenSocket, nullptr, nullptr);
+        if (socket < 0)
+            return;
+
+        std::unique_ptr<Session> session = std::make_unique<Session>();
+        session->socket = socket;
+        session->engine.setExecutor(&timeoutExecutor);
+        session->engine.setTimeout(timeout);
+        session->engine.setLimits(limits);
+        session->engine.setCacheCapacity(cacheCapacity);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        sessions[socket] = std::move(session);
+    }
+
+    void Server::receive(Session& session) {
+        char buffer[4096];
+        const ssize_t count = recv(session.socket, buffer, sizeof(buffer), 0);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (count <= 0) {
+            session.closing = true;
+            return;
+        }
+
+        session.buffer.append(buffer, count);
+
+        // commands are terminated by a semicolon like in the interactive mode
+        size_t begin = 0;
+        size_t end;
+        while ((end = session.buffer.find(';', begin)) != std::string::npos) {
+            const std::string text = session.buffer.substr(begin, end - begin);
+            if (!IOStream::isEmptyCommand(text))
+                session.pending.push_back(IOStream::parseCommand(text));
+
+            begin = end + 1;
+        }
+        session.buffer.erase(0, begin);
+
+        schedule(session);
+    }
+
+    void Server::closeFinishedSessions() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (auto it = sessions.begin(); it != sessions.end();) {
+            const Session& session = *it->second;
+            if (session.closing && !session.busy) {
+                close(session.socket);
+
+                // the engine of a poisoned session is still used by its abandoned command
+                if (session.engine.isPoisoned())
+                    abandonedSessions.push_back(std::move(it->second));
+
+                it = sessions.erase(it);
+            }
+            else {
+                it++;
+            }
+        }
+    }
+
+    void Server::schedule(Session& session) {
+        if (session.busy || session.pending.empty())
+            return;
+
+        session.busy = true;
+        workers.submit([this, &session]() { processSession(session); });
+    }
+
+    void Server::processSession(Session& session) {
+        std::stringstream output;
+        IOStream::setOutput(&output);
+
+        while (true) {
+            IOStream::Command command;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (session.pending.empty()) {
+                    session.busy = false;
+                    sessionIdle.notify_all();
+                    break;
+                }
+
+                command = std::move(session.pending.front());
+                session.pending.pop_front();
+            }
+
+            session.engine.execute(command);
+
+            output << '\0';
+            send(session.socket, output.str());
+            output.str("");
+
+            // the remaining commands are dropped after exit
+            if (!session.engine.isRunning()) {
+                std::lock_guard<std::mutex> lock(mutex);
+                session.pending.clear();
+                session.closing = true;
+            }
+        }
+
+        IOStream::setOutput(nullptr);
+
+        // the poll loop closes finished sessions
+        const char wakeup = 0;
+        [[maybe_unused]] ssize_t count = write(wakeupPipe[1], &wakeup, 1);
+    }
+
+    void Server::send(int socket, const std::string& str) {
+        size_t sent = 0;
+        while (sent < str.size()) {
+            const ssize_t count = ::send(socket, str.data() + sent, str.size() - sent, MSG_NOSIGNAL);
+            if (count <= 0)
+                return;
+
+            sent += count;
+        }
+    }
+#else
+    Server::Server(const std::string& path, size_t workerCount, std::chrono::milliseconds timeout, const ResourceLimits& limits,
+                   size_t cacheCapacity)
+        : path(path), timeout(timeout), limits(limits), cacheCapacity(cacheCapacity), timeoutExecutor(1), workers(workerCount) {
+        throw std::runtime_error("The server mode is not supported on windows");
+    }
+
+    Server::~Server() {
+    }
+
+    void Server::run() {
+    }
+#endif
+} // namespace cas::io
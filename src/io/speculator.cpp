@@ -0,0 +1,117 @@
+#include "io/speculator.hpp"
+
+#include "commands/differentialCalculus.hpp"
+#include "commands/termManipulation.hpp"
+
+#include "io/engine.hpp"
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cas {
+    Speculator::Speculator(Engine* engine)
+        : engine(engine) {
+        worker = std::thread(&Speculator::workerLoop, this);
+    }
+
+    Speculator::~Speculator() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            token.cancel();
+        }
+
+        condition.notify_all();
+        worker.join();
+    }
+
+    void Speculator::schedule(const math::VariableSymbol& symbol) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // the pending results would belong to old values
+            token.cancel();
+            token = math::CancellationToken();
+            pending.clear();
+
+            pending.push_back(symbol);
+            for (const math::VariableSymbol& dependent : engine->variables.getDependents(symbol)) {
+                pending.push_back(dependent);
+            }
+        }
+
+        condition.notify_one();
+    }
+
+    size_t Speculator::getCompleted() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return completed;
+    }
+
+    void Speculator::workerLoop() {
+#ifdef __linux__
+        // the commands of the user are not slowed down by the speculation
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#endif
+
+        while (true) {
+            math::VariableSymbol symbol;
+            math::CancellationToken jobToken;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [this]() { return stopping || !pending.empty(); });
+
+                if (stopping)
+                    return;
+
+                symbol = pending.front();
+                pending.pop_front();
+                jobToken = token;
+            }
+
+            math::CancellationScope cancellationScope(jobToken);
+            math::ResourceBudget budget(engine->getLimits());
+            math::BudgetScope budgetScope(&budget);
+            VariableScope variableScope(&engine->variables);
+
+            try {
+                precompute(symbol);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                completed++;
+            }
+            catch (const std::exception&) {
+                // speculative results are optional, the command of the user reports the error if it is executed
+            }
+        }
+    }
+
+    void Speculator::precompute(const math::VariableSymbol& symbol) {
+        ResultCache& cache = engine->resultCache;
+        if (!cache.isEnabled() || !engine->variables.contains(symbol))
+            return;
+
+        // the results are computed by the same commands and stored with the same keys as the commands of the user
+        auto store = [&cache](const std::string& alias, const auto& command, const std::vector<std::string>& args) {
+            ResultCache::Key key = ResultCache::makeKey(alias, args);
+            if (cache.contains(key))
+                return;
+
+            math::FrozenExpression result(command.execute(nullptr, args));
+            cache.insert(std::move(key), result);
+        };
+
+        store("simplify", commands::simplify, {symbol});
+
+        const math::FrozenExpression value = engine->variables.getSharedValue(symbol);
+        for (const math::Variable& var : value->getVariables()) {
+            math::checkCancellation();
+            store("D", commands::differentiate, {symbol, var.getSymbol()});
+        }
+
+        store("Df", commands::differential, {symbol});
+    }
+} // namespace cas
@@ -0,0 +1,286 @@
+#include "io/variableGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace cas {
+    thread_local VariableGraph* VariableGraph::current = nullptr;
+
+    bool VariableGraph::reaches(const std::set<math::VariableSymbol>& from, const math::VariableSymbol& to) const {
+        std::set<math::VariableSymbol> visited = from;
+        std::vector<math::VariableSymbol> pending(from.begin(), from.end());
+
+        while (!pending.empty()) {
+            const math::VariableSymbol symbol = std::move(pending.back());
+            pending.pop_back();
+
+            if (symbol == to)
+                return true;
+
+            auto it = nodes.find(symbol);
+            if (it == nodes.end())
+                continue;
+
+            for (const math::VariableSymbol& dependency : it->second.dependencies) {
+                if (visited.insert(dependency).second)
+                    pending.push_back(dependency);
+            }
+        }
+
+        return false;
+    }
+
+    void VariableGraph::invalidate(const math::VariableSymbol& symbol) {
+        auto it = nodes.find(symbol);
+        if (it != nodes.end()) {
+            // the dependents of a variable without value have already been invalidated
+            if (!it->second.value && it->second.definition)
+                return;
+
+            it->second.value = math::FrozenExpression();
+        }
+
+        auto dependentsIt = dependents.find(symbol);
+        if (dependentsIt == dependents.end())
+            return;
+
+        for (const math::VariableSymbol& dependent : dependentsIt->second) {
+            invalidate(dependent);
+        }
+    }
+
+    void VariableGraph::removeEdges(const math::VariableSymbol& symbol, const Node& node) {
+        for (const math::VariableSymbol& dependency : node.dependencies) {
+            auto it = dependents.find(dependency);
+            it->second.erase(symbol);
+
+            if (it->second.empty())
+                dependents.erase(it);
+        }
+    }
+
+    std::set<math::VariableSymbol> VariableGraph::getDependencies(const math::Expression* definition) {
+        std::set<math::VariableSymbol> dependencies;
+        for (const math::Variable& var : definition->getVariables()) {
+            dependencies.insert(var.getSymbol());
+        }
+
+        return dependencies;
+    }
+
+    void VariableGraph::define(const math::VariableSymbol& symbol, math::Expression* definition) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::set<math::VariableSymbol> dependencies = getDependencies(definition);
+        if (reaches(dependencies, symbol)) {
+            delete definition;
+            throw std::runtime_error("The definition of " + symbol + " depends on " + symbol + " itself");
+        }
+
+        assign(symbol, definition, std::move(dependencies));
+    }
+
+    void VariableGraph::defineAll(const std::vector<std::pair<math::VariableSymbol, math::Expression*>>& definitions) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // the dependencies after all definitions are replaced, a later definition of a symbol wins
+        std::map<math::VariableSymbol, std::set<math::VariableSymbol>> graph;
+        for (const auto& [symbol, node] : nodes) {
+            graph[symbol] = node.dependencies;
+        }
+
+        std::map<math::VariableSymbol, std::set<math::VariableSymbol>> newDependencies;
+        for (const auto& [symbol, definition] : definitions) {
+            newDependencies[symbol] = getDependencies(definition);
+            graph[symbol] = newDependencies[symbol];
+        }
+
+        // depth first search for a cycle. Symbols on the path of the search are in progress, the search closes the cycle
+        // at a symbol that depends on itself
+        std::set<math::VariableSymbol> inProgress, finished;
+        math::VariableSymbol cycleSymbol;
+        std::function<bool(const math::VariableSymbol&)> hasCycle = [&](const math::VariableSymbol& symbol) {
+            if (finished.contains(symbol))
+                return false;
+            if (!inProgress.insert(symbol).second) {
+                cycleSymbol = symbol;
+                return true;
+            }
+
+            auto it = graph.find(symbol);
+            if (it != graph.end() && std::any_of(it->second.begin(), it->second.end(), hasCycle))
+                return true;
+
+            inProgress.erase(symbol);
+            finished.insert(symbol);
+            return false;
+        };
+
+        for (const auto& [symbol, dependencies] : newDependencies) {
+            if (hasCycle(symbol)) {
+                for (const auto& [definedSymbol, definition] : definitions) {
+                    delete definition;
+                }
+
+                throw std::runtime_error("The definition of " + cycleSymbol + " depends on " + cycleSymbol + " itself");
+            }
+        }
+
+        for (const auto& [symbol, definition] : definitions) {
+            // a symbol defined twice is assigned twice, so the first definition is released
+            assign(symbol, definition, getDependencies(definition));
+        }
+    }
+
+    void VariableGraph::assign(const math::VariableSymbol& symbol, math::Expression* definition, std::set<math::VariableSymbol> dependencies) {
+        // the dependents keep the old value until now, so invalidate them before the node is replaced
+        invalidate(symbol);
+
+        Node& node = nodes[symbol];
+        removeEdges(symbol, node);
+
+        node.definition = math::FrozenExpression(definition);
+        node.value = math::FrozenExpression();
+        node.dependencies = std::move(dependencies);
+
+        for (const math::VariableSymbol& dependency : node.dependencies) {
+            dependents[dependency].insert(symbol);
+        }
+    }
+
+    const math::FrozenExpression& VariableGraph::resolve(const math::VariableSymbol& symbol) {
+        Node& node = nodes.at(symbol);
+        if (!node.value) {
+            node.value = math::FrozenExpression(substituteResolved(node.definition.get()));
+            recomputations++;
+        }
+
+        return node.value;
+    }
+
+    math::Expression* VariableGraph::substituteResolved(const math::Expression* expr, const std::set<math::VariableSymbol>& excluded) {
+        math::Expression* result = expr->copy();
+
+        for (math::Variable var : expr->getVariables()) {
+            if (!nodes.contains(var.getSymbol()) || excluded.contains(var.getSymbol()))
+                continue;
+
+            const math::FrozenExpression& value = resolve(var.getSymbol());
+
+            // setVariable only replaces the children of an expression
+            if (result->getType() == math::ExpressionTypes::Variable) {
+                delete result;
+                return value.thaw();
+            }
+
+            result->setVariable(&var, const_cast<math::Expression*>(value.get()));
+        }
+
+        return result;
+    }
+
+    bool VariableGraph::contains(const math::VariableSymbol& symbol) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return nodes.contains(symbol);
+    }
+
+    std::vector<math::VariableSymbol> VariableGraph::getSymbols() const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::vector<math::VariableSymbol> symbols;
+        for (const auto& [symbol, node] : nodes) {
+            symbols.push_back(symbol);
+        }
+
+        return symbols;
+    }
+
+    math::Expression* VariableGraph::getDefinition(const math::VariableSymbol& symbol) const {
+        math::FrozenExpression definition;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            auto it = nodes.find(symbol);
+            if (it == nodes.end())
+                throw std::runtime_error("Variable " + symbol + " is not defined");
+
+            definition = it->second.definition;
+        }
+
+        // the copy is created without holding the lock
+        return definition.thaw();
+    }
+
+    math::Expression* VariableGraph::getValue(const math::VariableSymbol& symbol) {
+        return getSharedValue(symbol).thaw();
+    }
+
+    math::FrozenExpression VariableGraph::getSharedValue(const math::VariableSymbol& symbol) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!nodes.contains(symbol))
+            throw std::runtime_error("Variable " + symbol + " is not defined");
+
+        return resolve(symbol);
+    }
+
+    std::vector<math::VariableSymbol> VariableGraph::getDependents(const math::VariableSymbol& symbol) const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::set<math::VariableSymbol> visited;
+        std::vector<math::VariableSymbol> order;
+
+        // depth first search, every variable is added after all of its dependents
+        std::function<void(const math::VariableSymbol&)> visit = [&](const math::VariableSymbol& current) {
+            auto it = dependents.find(current);
+            if (it == dependents.end())
+                return;
+
+            for (const math::VariableSymbol& dependent : it->second) {
+                if (visited.insert(dependent).second) {
+                    visit(dependent);
+                    order.push_back(dependent);
+                }
+            }
+        };
+        visit(symbol);
+
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    math::Expression* VariableGraph::substitute(const math::Expression* expr, const std::set<math::VariableSymbol>& excluded) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return substituteResolved(expr, excluded);
+    }
+
+    bool VariableGraph::referencesVariables(const math::Expression* expr) const {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        for (const math::Variable& var : expr->getVariables()) {
+            if (nodes.contains(var.getSymbol()))
+                return true;
+        }
+
+        return false;
+    }
+
+    size_t VariableGraph::getRecomputations() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return recomputations;
+    }
+
+    VariableGraph* VariableGraph::getCurrent() {
+        return current;
+    }
+
+    VariableScope::VariableScope(VariableGraph* graph)
+        : previous(VariableGraph::current) {
+        VariableGraph::current = graph;
+    }
+
+    VariableScope::~VariableScope() {
+        VariableGraph::current = previous;
+    }
+} // namespace cas
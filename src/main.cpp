@@ -1,11 +1,189 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <thread>
 
 #include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/parseCache.hpp"
+#include "io/protocol.hpp"
+#include "io/server.hpp"
 
 using namespace cas;
 
+namespace {
+    void printUsage() {
+        std::cerr << "Usage: cas [--batch [file] | --protocol [--workers <count>] | --server <socket> [--workers <count>]] [--timeout <seconds>] [--max-nodes <count>] [--max-bytes <count>] [--max-depth <count>] [--cache-size <bytes>] [--parse-cache-size <bytes>] [--speculate] [--load <snapshot>] [--log <file>] [--log-level <info|error>] [--log-max-size <bytes>] [--log-files <count>] [--no-log]" << std::endl;
+    }
+} // namespace
+
 int main(int argCnt, char** args) {
+    bool batch = false;
+    bool protocol = false;
+    std::string inputPath;
+    bool speculate = false;
+    io::LoggerOptions logOptions;
+    bool logPathSet = false;
+    std::string socketPath;
+    size_t workerCount = std::thread::hardware_concurrency();
+    std::chrono::milliseconds timeout(0);
+    ResourceLimits limits;
+    size_t cacheCapacity = ResultCache::defaultCapacity;
+    std::string snapshotPath;
+
+    for (int i = 1; i < argCnt; i++) {
+        const std::string arg = args[i];
+
+        if (arg == "--batch") {
+            batch = true;
+
+            // the input file is optional, without it the commands are read from stdin
+            if (i + 1 < argCnt && args[i + 1][0] != '-')
+                inputPath = args[++i];
+        }
+        else if (arg == "--protocol") {
+            protocol = true;
+        }
+        else if (arg == "--server" && i + 1 < argCnt) {
+            socketPath = args[++i];
+        }
+        else if (arg == "--workers" && i + 1 < argCnt) {
+            workerCount = std::max(1, std::atoi(args[++i]));
+        }
+        else if (arg == "--timeout" && i + 1 < argCnt) {
+            timeout = std::chrono::milliseconds(static_cast<long long>(std::atof(args[++i]) * 1000));
+        }
+        else if (arg == "--max-nodes" && i + 1 < argCnt) {
+            limits.maxNodes = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if (arg == "--max-bytes" && i + 1 < argCnt) {
+            limits.maxBytes = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if (arg == "--max-depth" && i + 1 < argCnt) {
+            limits.maxDepth = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if (arg == "--cache-size" && i + 1 < argCnt) {
+            cacheCapacity = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if (arg == "--parse-cache-size" && i + 1 < argCnt) {
+            io::ParseCache::shared().setCapacity(std::strtoull(args[++i], nullptr, 10));
+        }
+        else if (arg == "--speculate") {
+            speculate = true;
+        }
+        else if (arg == "--load" && i + 1 < argCnt) {
+            snapshotPath = args[++i];
+        }
+        else if (arg == "--log" && i + 1 < argCnt) {
+            logOptions.path = args[++i];
+            logPathSet = true;
+        }
+        else if (arg == "--log-level" && i + 1 < argCnt) {
+            const std::string level = args[++i];
+            if (level == "info") {
+                logOptions.level = io::LogLevel::Info;
+            }
+            else if (level == "error") {
+                logOptions.level = io::LogLevel::Error;
+            }
+            else {
+                printUsage();
+                return 2;
+            }
+        }
+        else if (arg == "--log-max-size" && i + 1 < argCnt) {
+            logOptions.maxFileSize = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if (arg == "--log-files" && i + 1 < argCnt) {
+            logOptions.maxFiles = std::strtoull(args[++i], nullptr, 10);
+        }
+        else if (arg == "--no-log") {
+            logOptions.path.clear();
+            logPathSet = true;
+        }
+        else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    if (!socketPath.empty()) {
+        // sessions are only logged on request
+        if (!logPathSet)
+            logOptions.path.clear();
+
+        try {
+            io::IOStream::setLog(logOptions);
+
+            io::Server server(socketPath, workerCount, timeout, limits, cacheCapacity);
+            server.run();
+        }
+        catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    std::ifstream inputFile;
+    if (!inputPath.empty()) {
+        inputFile.open(inputPath);
+        if (!inputFile) {
+            std::cerr << "Cannot open " << inputPath << std::endl;
+            return 2;
+        }
+
+        io::IOStream::setInput(inputFile);
+    }
+
+    if (batch || protocol) {
+        // the output is only flushed when the buffer is full or the input ends
+        std::ios::sync_with_stdio(false);
+        std::cin.tie(nullptr);
+
+        io::IOStream::setPrompt(false);
+
+        // batch runs and protocol sessions are only logged on request
+        if (!logPathSet)
+            logOptions.path.clear();
+    }
+
+    try {
+        io::IOStream::setLog(logOptions);
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
     Engine engine;
+    engine.setBatchMode(batch);
+    engine.setTimeout(timeout);
+    engine.setLimits(limits);
+    engine.setCacheCapacity(cacheCapacity);
+    engine.setSpeculation(speculate);
+
+    if (!snapshotPath.empty()) {
+        try {
+            engine.loadSnapshot(snapshotPath);
+        }
+        catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (protocol) {
+        // the requests are read from the input file of --batch like the commands of a batch run
+        std::istream& input = inputFile.is_open() ? static_cast<std::istream&>(inputFile) : std::cin;
+
+        io::Protocol session(engine, input, std::cout, workerCount);
+        return session.run();
+    }
 
-    engine.run();
+    return engine.run();
 }
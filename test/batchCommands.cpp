@@ -0,0 +1,68 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+bool checkOutput(Engine& engine, const std::string& command, const std::string& expected) {
+    const std::string output = execute(engine, command);
+    if (output != expected) {
+        std::cout << "wrong output of " << command << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << output;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    Engine engine;
+
+    // the elements of a list give the same results as single commands
+    const std::string first = execute(engine, "D[x^2, x]");
+    const std::string second = execute(engine, "D[x*y, x]");
+    missmatch |= checkOutput(engine, "D[[x^2, x*y], x]", "[" + first.substr(0, first.size() - 1) + ", " + second.substr(0, second.size() - 1) + "]\n");
+
+    // lists of several arguments are expanded together
+    const std::string third = execute(engine, "D[y^2, y]");
+    missmatch |= checkOutput(engine, "D[[x^2, y^2], [x, y]]", "[" + first.substr(0, first.size() - 1) + ", " + third.substr(0, third.size() - 1) + "]\n");
+
+    // the outputs of results that are not expressions are framed by element
+    missmatch |= checkOutput(engine, "roots[[x^2-1, x+3], x]", "Element 1:\n-1\n1\nElement 2:\n-3\n");
+
+    // empty lists give empty results
+    missmatch |= checkOutput(engine, "D[[], x]", "[]\n");
+    missmatch |= checkOutput(engine, "roots[[ ], x]", "[]\n");
+
+    // lists of different length
+    missmatch |= checkOutput(engine, "D[[x^2, y^2], [x]]", "All lists of a command must have the same length\n");
+
+    // every element is cached on its own, so a known element is a hit in another list
+    Engine cachedEngine;
+    execute(cachedEngine, "D[[x^3, x^4], x]");
+    const ResultCache::Statistics before = cachedEngine.getCacheStatistics();
+    execute(cachedEngine, "D[[x^4, x^5], x]");
+    const ResultCache::Statistics after = cachedEngine.getCacheStatistics();
+
+    if (before.misses != 2 || after.hits - before.hits != 1 || after.misses - before.misses != 1) {
+        std::cout << "the elements of a list are not cached separately" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+struct BatchResult {
+    int status;
+    std::string output;
+    std::string errors;
+};
+
+// runs the commands like cas --batch, the results are written to stdout and the errors to stderr
+BatchResult runBatch(const std::string& commands) {
+    std::stringstream input(commands);
+    std::stringstream output, errors;
+
+    std::streambuf* coutBuffer = std::cout.rdbuf(output.rdbuf());
+    std::streambuf* cerrBuffer = std::cerr.rdbuf(errors.rdbuf());
+
+    IOStream::setInput(input);
+    IOStream::setPrompt(false);
+
+    Engine engine;
+    engine.setBatchMode(true);
+    const int status = engine.run();
+
+    std::cout.rdbuf(coutBuffer);
+    std::cerr.rdbuf(cerrBuffer);
+    IOStream::setInput(std::cin);
+
+    return {status, output.str(), errors.str()};
+}
+
+bool checkBatch(const std::string& commands, int status, const std::string& output, const std::string& errors) {
+    const BatchResult result = runBatch(commands);
+    if (result.status != status || result.output != output || result.errors != errors) {
+        std::cout << "wrong result of the batch " << commands << std::endl;
+        std::cout << "expected: " << status << " | " << output << " | " << errors << std::endl;
+        std::cout << "got:      " << result.status << " | " << result.output << " | " << result.errors << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // all commands succeed
+    missmatch |= checkBatch("a=2; a; simplify[1+2]", 0, "2\n2\n3\n", "");
+
+    // a failed command is reported with its number and the following commands are still executed
+    missmatch |= checkBatch("simplify[1+2]; foo[x]; simplify[2+2]", 1, "3\n4\n", "Error in command 2 (foo): Command \"foo\" not found!\n");
+    missmatch |= checkBatch("D[x^2]; simplify[1+2]", 1, "3\n", "Error in command 1 (D): The command expects 2 arguments\n");
+
+    // every failed command is reported
+    missmatch |= checkBatch("b; c", 1, "", "Error in command 1 (b): Command \"b\" not found!\nError in command 2 (c): Command \"c\" not found!\n");
+
+    // empty commands are skipped and not counted
+    missmatch |= checkBatch(" ; ;simplify[1+1];;", 0, "2\n", "");
+
+    // no commands are read after exit
+    const BatchResult exited = runBatch("simplify[1+1]; exit; foo");
+    if (exited.status != 0 || !exited.errors.empty()) {
+        std::cout << "the commands after exit were executed" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/parser.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+bool checkOutput(Engine& engine, const std::string& command, const std::string& expected) {
+    const std::string output = execute(engine, command);
+    if (output != expected) {
+        std::cout << "wrong output of " << command << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << output;
+        return true;
+    }
+
+    return false;
+}
+
+// the exterior differential built sequentially like the Df command did before the partial derivatives were parallel
+std::string sequentialDifferential(const std::string& exprStr) {
+    std::unique_ptr<Expression> expr(Parser::parse(exprStr));
+    const std::set<Variable> vars = expr->getVariables();
+
+    auto it = vars.begin();
+    Expression* result = new Multiplication(expr->differentiate(&(*it)), new Differential(it->getSymbol()));
+    for (it++; it != vars.end(); it++) {
+        result = new Addition(result, new Multiplication(expr->differentiate(&(*it)), new Differential(it->getSymbol())));
+    }
+
+    const std::string str = result->toString();
+    delete result;
+    return str;
+}
+
+std::string simplifiedDerivative(const std::string& exprStr, const std::string& var) {
+    std::unique_ptr<Expression> expr(Parser::parse(exprStr));
+    std::unique_ptr<Expression> derivative(D(expr.get(), Variable(var)));
+    std::unique_ptr<Expression> simplified(derivative->simplify());
+
+    return simplified->toString();
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    Engine engine;
+
+    // Df gives the derivatives in the same form as before
+    for (const std::string exprStr : {"2*x*y", "x^2+y*z", "sin(x)*y+e^z"}) {
+        missmatch |= checkOutput(engine, "Df[" + exprStr + "]", sequentialDifferential(exprStr) + "\n");
+    }
+    missmatch |= checkOutput(engine, "Df[3]", "0\n");
+
+    // one row per function, one column per variable
+    missmatch |= checkOutput(engine, "jacobian[[x*y, x+y^2], [x, y]]",
+                             "[" + simplifiedDerivative("x*y", "x") + ", " + simplifiedDerivative("x*y", "y") + "]\n[" + simplifiedDerivative("x+y^2", "x") +
+                                 ", " + simplifiedDerivative("x+y^2", "y") + "]\n");
+    missmatch |= checkOutput(engine, "jacobian[[x*y], [y, x]]", "[" + simplifiedDerivative("x*y", "y") + ", " + simplifiedDerivative("x*y", "x") + "]\n");
+
+    // the partial derivatives are in the order of the variables, also if they are split between several threads
+    const std::string symbols = "abcdfghjklmnopqrstuvwxyz";
+    std::string polynomial;
+    std::vector<Variable> variables;
+    for (size_t i = 0; i < symbols.size(); i++) {
+        const std::string symbol(1, symbols[i]);
+        polynomial += (i > 0 ? "+" : "") + std::to_string(i + 1) + "*" + symbol + "^2";
+        variables.emplace_back(symbol);
+    }
+
+    std::unique_ptr<Expression> expr(Parser::parse(polynomial));
+    std::vector<Expression*> partials = partialDerivatives(expr.get(), std::vector<Variable>(variables.rbegin(), variables.rend()), true);
+    for (size_t i = 0; i < partials.size(); i++) {
+        const std::string expected = simplifiedDerivative(polynomial, variables[variables.size() - 1 - i].getSymbol());
+        if (partials[i]->toString() != expected) {
+            std::cout << "partial derivative " << i << " is " << partials[i]->toString() << " instead of " << expected << std::endl;
+            missmatch = true;
+        }
+
+        delete partials[i];
+    }
+
+    return missmatch;
+}
@@ -0,0 +1,64 @@
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/parser.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+void writeSnapshot(const std::string& path, const std::vector<std::pair<std::string, std::string>>& definitions) {
+    SnapshotWriter writer;
+    for (const auto& [name, definition] : definitions) {
+        Expression* expr = Parser::parse(definition);
+        writer.add(name, expr);
+        delete expr;
+    }
+
+    writer.write(path);
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    const std::string path = "engine_snapshot_test.snapshot";
+
+    Engine engine;
+    execute(engine, "a=1");
+
+    // c is valid on its own, but a and b depend on each other, so nothing is loaded
+    writeSnapshot(path, {{"c", "2"}, {"a", "b+1"}, {"b", "a+1"}, {"", "x^2"}});
+    try {
+        engine.loadSnapshot(path);
+        std::cout << "a snapshot with a cycle was loaded" << std::endl;
+        missmatch = true;
+    }
+    catch (const std::runtime_error&) {
+    }
+
+    if (execute(engine, "ans") != "1\n" || execute(engine, "a") != "1\n" || execute(engine, "listVars").find('c') != std::string::npos) {
+        std::cout << "a failed load changed the engine" << std::endl;
+        missmatch = true;
+    }
+
+    // the definitions of a snapshot may depend on each other in any order
+    writeSnapshot(path, {{"a", "b+1"}, {"b", "2"}, {"", "x^2"}});
+    if (engine.loadSnapshot(path) != 3 || execute(engine, "ans") != "x^2\n" || execute(engine, "a") != "2+1\n") {
+        std::cout << "the snapshot was not loaded" << std::endl;
+        missmatch = true;
+    }
+
+    std::remove(path.c_str());
+    return missmatch;
+}
@@ -0,0 +1,82 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+bool execute(Engine& engine, const std::string& command, std::string& output) {
+    std::stringstream stream;
+    IOStream::setOutput(&stream);
+    const bool succeeded = engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    output = stream.str();
+    return succeeded;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    std::string output;
+
+    Engine engine;
+    engine.setTimeout(std::chrono::milliseconds(50));
+
+    // reaches a cancellation point after the timeout
+    engine.addCommand("spin", Command<std::string>([](Engine* engine) {
+        while (true) {
+            checkCancellation();
+        }
+
+        return std::string();
+    }));
+
+    // ignores the cancellation
+    engine.addCommand("stall", Command<std::string>([](Engine* engine) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+        return std::string("stalled");
+    }));
+
+    if (execute(engine, "spin", output) || output.find("timed out") == std::string::npos) {
+        std::cout << "spin was not cancelled: " << output << std::endl;
+        missmatch = true;
+    }
+
+    if (!execute(engine, "D[x^2, x]", output) || engine.isPoisoned()) {
+        std::cout << "the engine is not usable after a cancelled command" << std::endl;
+        missmatch = true;
+    }
+
+    // the command is abandoned after the grace period instead of blocking the session
+    std::stringstream stallOutput;
+    IOStream::setOutput(&stallOutput);
+    const auto start = std::chrono::steady_clock::now();
+    const bool stalled = engine.execute(IOStream::parseCommand("stall"));
+    const auto duration = std::chrono::steady_clock::now() - start;
+    IOStream::setOutput(nullptr);
+
+    if (stalled || duration >= std::chrono::milliseconds(1400) || !engine.isPoisoned() || engine.isRunning()) {
+        std::cout << "stall was not abandoned: " << stallOutput.str() << std::endl;
+        missmatch = true;
+    }
+
+    if (execute(engine, "D[x^2, x]", output)) {
+        std::cout << "a poisoned engine executed a command" << std::endl;
+        missmatch = true;
+    }
+
+    // the engine can only be destroyed after the abandoned command stopped. Its result is not written to the output of
+    // the call that abandoned it
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    if (stallOutput.str().find("stalled") != std::string::npos) {
+        std::cout << "the abandoned command wrote to the output of the caller" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
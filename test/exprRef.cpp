@@ -0,0 +1,51 @@
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <expressions/operations.hpp>
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // a moved handle gives its tree to the new expression
+    ExprRef x(new Variable("x"));
+    const Expression* tree = x.get();
+    Expression* sum = add(std::move(x), 2);
+    if (static_cast<Addition*>(sum)->left != tree || x) {
+        std::cout << "the tree of a moved handle was copied" << std::endl;
+        missmatch = true;
+    }
+    delete sum;
+
+    // a shared tree is copied and stays valid for the other handles
+    ExprRef y(new Exponentiation(new Variable("y"), new Number(2)));
+    ExprRef other = y;
+    Expression* product = multiply(y, std::move(other));
+    if (y.getUseCount() != 1 || product->toString() != "y^2*y^2" || y->toString() != "y^2") {
+        std::cout << "sharing the handle failed: " << product->toString() << std::endl;
+        missmatch = true;
+    }
+    delete product;
+
+    // the tree of a frozen expression is shared, but never given away
+    FrozenExpression frozen(new Addition(new Variable("z"), new Number(1)));
+    ExprRef shared(frozen);
+    if (shared.get() != frozen.get() || frozen.getUseCount() != 2) {
+        std::cout << "the frozen tree was not shared" << std::endl;
+        missmatch = true;
+    }
+
+    frozen = FrozenExpression();
+    const Expression* frozenTree = shared.get();
+    Expression* taken = shared.take();
+    if (taken == frozenTree || taken->toString() != "z+1") {
+        std::cout << "the tree of a frozen expression was moved out" << std::endl;
+        missmatch = true;
+    }
+    delete taken;
+
+    return missmatch;
+}
@@ -0,0 +1,45 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+bool checkParallelMatches(const std::string& exprStr, const std::string& patternStr) {
+    Expression* expr = Parser::parse(exprStr);
+    Expression* pattern = Parser::parse(patternStr);
+
+    // a small threshold splits even small expressions into several tasks
+    const std::vector<ExpressionMatch> sequential = ExpressionMatcher::matchAllParallel(expr, pattern, SIZE_MAX);
+    const std::vector<ExpressionMatch> parallel = ExpressionMatcher::matchAllParallel(expr, pattern, 1);
+
+    bool missmatch = sequential.size() != parallel.size();
+    for (size_t i = 0; !missmatch && i < sequential.size(); i++) {
+        missmatch = sequential[i].node != parallel[i].node;
+    }
+
+    if (missmatch)
+        std::cout << "parallel matches of " << patternStr << " in " << exprStr << " differ from the sequential matches" << std::endl;
+
+    delete expr;
+    delete pattern;
+    return missmatch;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    std::string sum = "x^1";
+    for (int i = 2; i <= 200; i++) {
+        sum += "+y*x^" + std::to_string(i);
+    }
+
+    missmatch |= checkParallelMatches(sum, "x^a");
+    missmatch |= checkParallelMatches("sin(x^2)*(x^3+y^x)+z^(x^4)", "x^a");
+    missmatch |= checkParallelMatches("x+y", "a+b");
+
+    return missmatch ? 1 : 0;
+}
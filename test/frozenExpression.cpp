@@ -0,0 +1,54 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    const FrozenExpression expr(Parser::parse("x^3*sin(y)+y*x"));
+    const FrozenExpression expected(Parser::parse("3*x^2*sin(y)+y"));
+
+    // all threads read the same tree and create their own versions
+    std::vector<FrozenExpression> results(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); i++) {
+        threads.emplace_back([&expr, &results, i]() {
+            FrozenExpression shared = expr;
+            for (int k = 0; k < 100; k++) {
+                results[i] = shared.differentiate(Variable("x")).simplify();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (const FrozenExpression& result : results) {
+        if (!(result == expected)) {
+            std::cout << "expected: " << expected->toString() << " got: " << result->toString() << std::endl;
+            missmatch = true;
+        }
+    }
+
+    if (expr.getUseCount() != 1) {
+        std::cout << "the handles of the threads were not released" << std::endl;
+        missmatch = true;
+    }
+
+    // changes create a new version
+    const FrozenExpression substituted = expr.substitute(Variable("y"), FrozenExpression(new Number(2)));
+    if (expr->toString() != "x^3*sin(y)+y*x" || substituted->toString() != "x^3*sin(2)+2*x") {
+        std::cout << "substitution changed the frozen expression or is wrong: " << substituted->toString() << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <sstream>
+#include <string>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/parser.hpp"
+
+using namespace cas;
+using namespace cas::io;
+using namespace cas::math;
+
+IntegrationResult integrate(const std::string& integrand, double a, double b, const IntegrationOptions& options = {}) {
+    std::unique_ptr<Expression> expr(Parser::parse(integrand));
+    return integrate(expr.get(), Variable("x"), a, b, options);
+}
+
+// every refined interval is replaced by two halves of 15 points each
+bool checkCounts(const std::string& integrand, const IntegrationResult& result) {
+    if (result.intervals == 0 || result.evaluations != 15 + 30 * (result.intervals - 1)) {
+        std::cout << "wrong counts of the integral of " << integrand << ": " << result.evaluations << " evaluations, " << result.intervals << " intervals" << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+// the integral has to converge to the exact value and the error estimate has to bound the actual error
+bool checkIntegral(const std::string& integrand, double a, double b, double exact) {
+    const IntegrationResult result = integrate(integrand, a, b);
+    const double error = std::abs(result.value - exact);
+
+    if (!result.converged || error > 1e-9 * std::max(1.0, std::abs(exact))) {
+        std::cout << "wrong integral of " << integrand << " over [" << a << ", " << b << "]" << std::endl;
+        std::cout << "expected: " << exact << std::endl;
+        std::cout << "got:      " << result.value << (result.converged ? "" : " (not converged)") << std::endl;
+        return true;
+    }
+
+    if (result.error < error) {
+        std::cout << "the error estimate " << result.error << " of the integral of " << integrand << " is below the actual error " << error << std::endl;
+        return true;
+    }
+
+    return checkCounts(integrand, result);
+}
+
+bool checkOutput(Engine& engine, const std::string& command, const std::string& value, const std::string& counts) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    const std::string result = output.str();
+    if (!result.starts_with(value + "\nError estimate: ") || !result.ends_with(counts + "\n")) {
+        std::cout << "wrong output of " << command << std::endl;
+        std::cout << "expected: " << value << " ... " << counts << std::endl;
+        std::cout << "got:      " << result;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // polynomials up to degree 13 are integrated exactly by the first interval
+    missmatch |= checkIntegral("x^3", 0, 2, 4);
+    missmatch |= checkIntegral("3*x^2+2*x-1", -1, 3, 32);
+    missmatch |= checkIntegral("x^13", -1, 1, 0);
+    const IntegrationResult polynomial = integrate("x^5-x", 0, 1);
+    if (polynomial.intervals != 1 || polynomial.evaluations != 15) {
+        std::cout << "a polynomial needed " << polynomial.intervals << " intervals and " << polynomial.evaluations << " evaluations" << std::endl;
+        missmatch = true;
+    }
+
+    // reversed bounds change the sign, equal bounds give zero without evaluations
+    missmatch |= checkIntegral("x^3", 2, 0, -4);
+    const IntegrationResult empty = integrate("x^2", 1, 1);
+    if (empty.value != 0 || empty.evaluations != 0 || !empty.converged) {
+        std::cout << "an integral over an empty interval was evaluated" << std::endl;
+        missmatch = true;
+    }
+
+    // smooth functions
+    missmatch |= checkIntegral("sin(x)", 0, std::numbers::pi, 2);
+    missmatch |= checkIntegral("e^x", 0, 1, std::numbers::e - 1);
+    missmatch |= checkIntegral("e^x", -3, 5, std::exp(5) - std::exp(-3));
+    missmatch |= checkIntegral("cos(x)^2", 0, 10 * std::numbers::pi, 5 * std::numbers::pi);
+
+    // the singularity at zero needs refined intervals
+    const IntegrationResult singular = integrate("x^(-0.5)", 0, 1);
+    if (!singular.converged || singular.intervals < 2 || std::abs(singular.value - 2) > 1e-8 || singular.error < std::abs(singular.value - 2)) {
+        std::cout << "wrong integral of x^(-0.5): " << singular.value << " with error estimate " << singular.error << " in " << singular.intervals << " intervals" << std::endl;
+        missmatch = true;
+    }
+    missmatch |= checkCounts("x^(-0.5)", singular);
+
+    // the interval limit stops the refinement before the tolerance is reached
+    for (size_t maxIntervals : {1, 4, 100}) {
+        const IntegrationResult limited = integrate("sin(1000000*x)", 0, 1000, {1e-10, 1e-10, maxIntervals});
+        if (limited.converged || limited.intervals != maxIntervals) {
+            std::cout << "the integral of an oscillating function with " << maxIntervals << " intervals used " << limited.intervals << " intervals"
+                      << (limited.converged ? " and converged" : "") << std::endl;
+            missmatch = true;
+        }
+        missmatch |= checkCounts("sin(1000000*x)", limited);
+    }
+
+    // the command prints the value, the error estimate and the counts
+    Engine engine;
+    missmatch |= checkOutput(engine, "integrate[x^2, x, 0, 3]", "9", "Evaluations: 15, subintervals: 1");
+    missmatch |= checkOutput(engine, "integrate[3*t^2, t, 1, 2]", "7", "Evaluations: 15, subintervals: 1");
+
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand("integrate[sin(1000000*x), x, 0, 1000]"));
+    IOStream::setOutput(nullptr);
+    if (output.str().find("(tolerance not reached)") == std::string::npos || !output.str().ends_with("Evaluations: 122865, subintervals: 4096\n")) {
+        std::cout << "the command does not report that the tolerance was not reached" << std::endl;
+        std::cout << "got: " << output.str();
+        missmatch = true;
+    }
+
+    return missmatch;
+}
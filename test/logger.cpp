@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "io/logger.hpp"
+
+using namespace cas::io;
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+bool checkFile(const std::string& path, const std::string& expected) {
+    const std::string content = readFile(path);
+    if (content != expected) {
+        std::cout << "wrong content of " << path << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << content;
+        return true;
+    }
+
+    return false;
+}
+
+void removeFiles(const std::string& path) {
+    std::remove(path.c_str());
+    for (int i = 1; i <= 3; i++) {
+        std::remove((path + "." + std::to_string(i)).c_str());
+    }
+}
+
+std::string makeRecord(size_t number) {
+    std::string digits = std::to_string(number);
+    return "record " + std::string(2 - std::min<size_t>(digits.size(), 2), '0') + digits + "\n";
+}
+
+std::string makeRecords(size_t begin, size_t end) {
+    std::string records;
+    for (size_t i = begin; i < end; i++) {
+        records += makeRecord(i);
+    }
+
+    return records;
+}
+
+// every thread logs its records in order into a small buffer. Each written record has to appear once and in order, the
+// records that are not written have to be counted as dropped
+bool checkStress(const std::string& path, size_t threadCount, size_t recordCount, size_t capacity) {
+    removeFiles(path);
+    {
+        Logger logger(LoggerOptions{path, LogLevel::Info, 0, 3, capacity});
+
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < threadCount; thread++) {
+            threads.emplace_back([&logger, thread, recordCount]() {
+                for (size_t i = 0; i < recordCount; i++) {
+                    logger.log(LogLevel::Info, std::to_string(thread) + " " + std::to_string(i) + "\n");
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    bool missmatch = false;
+    std::vector<long long> last(threadCount, -1);
+    size_t written = 0;
+    size_t dropped = 0;
+
+    std::stringstream content(readFile(path));
+    std::string line;
+    while (std::getline(content, line)) {
+        size_t count;
+        if (std::sscanf(line.c_str(), "[%zu log records dropped]", &count) == 1) {
+            dropped += count;
+            continue;
+        }
+
+        size_t thread, number;
+        if (std::sscanf(line.c_str(), "%zu %zu", &thread, &number) != 2 || thread >= threadCount || static_cast<long long>(number) <= last[thread]) {
+            if (!missmatch)
+                std::cout << "the record \"" << line << "\" is invalid, duplicated or out of order" << std::endl;
+            missmatch = true;
+            continue;
+        }
+
+        last[thread] = static_cast<long long>(number);
+        written++;
+    }
+
+    if (written + dropped != threadCount * recordCount) {
+        std::cout << written << " records were written and " << dropped << " were dropped, but " << threadCount * recordCount << " were logged" << std::endl;
+        missmatch = true;
+    }
+
+    // the buffer holds far fewer records than are logged at the same time
+    if (capacity <= 4 && dropped == 0) {
+        std::cout << "no records were dropped by a buffer of " << capacity << " records" << std::endl;
+        missmatch = true;
+    }
+
+    removeFiles(path);
+    return missmatch;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    const std::string path = "logger_test.log";
+    removeFiles(path);
+
+    // records below the level are discarded
+    {
+        Logger logger(LoggerOptions{path, LogLevel::Error});
+        if (logger.isEnabled(LogLevel::Info) || !logger.isEnabled(LogLevel::Error)) {
+            std::cout << "wrong levels enabled" << std::endl;
+            missmatch = true;
+        }
+
+        logger.log(LogLevel::Info, "info\n");
+        logger.log(LogLevel::Error, "error\n");
+        logger.log(LogLevel::Info, "info\n");
+        logger.flush();
+        missmatch |= checkFile(path, "error\n");
+    }
+
+    // flush returns after all records logged before are written to the file
+    {
+        Logger logger(LoggerOptions{path});
+        std::string expected;
+        for (size_t round = 0; round < 20; round++) {
+            for (size_t i = 0; i < 100; i++) {
+                logger.log(LogLevel::Info, makeRecord(i));
+            }
+            expected += makeRecords(0, 100);
+
+            logger.flush();
+            if (readFile(path) != expected) {
+                std::cout << "flush returned before all records were written in round " << round << std::endl;
+                missmatch = true;
+                break;
+            }
+        }
+    }
+
+    // the file is rotated before it grows larger than the maximum size. Every file holds ten records of ten bytes and
+    // only the two newest rotated files are kept
+    {
+        Logger logger(LoggerOptions{path, LogLevel::Info, 100, 2});
+        for (size_t i = 0; i < 35; i++) {
+            logger.log(LogLevel::Info, makeRecord(i));
+        }
+        logger.flush();
+    }
+    missmatch |= checkFile(path, makeRecords(30, 35));
+    missmatch |= checkFile(path + ".1", makeRecords(20, 30));
+    missmatch |= checkFile(path + ".2", makeRecords(10, 20));
+    if (std::filesystem::exists(path + ".3")) {
+        std::cout << "more rotated files than the maximum were kept" << std::endl;
+        missmatch = true;
+    }
+    removeFiles(path);
+
+    // without rotated files the old records are removed
+    {
+        Logger logger(LoggerOptions{path, LogLevel::Info, 100, 0});
+        for (size_t i = 0; i < 25; i++) {
+            logger.log(LogLevel::Info, makeRecord(i));
+        }
+    }
+    missmatch |= checkFile(path, makeRecords(20, 25));
+    if (std::filesystem::exists(path + ".1")) {
+        std::cout << "a file was rotated although no rotated files are kept" << std::endl;
+        missmatch = true;
+    }
+
+    // stress test with many threads, a tiny buffer drops records
+    const size_t threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+    missmatch |= checkStress(path, threadCount, 20000, 2);
+    missmatch |= checkStress(path, threadCount, 20000, 64);
+    missmatch |= checkStress(path, threadCount, 2000, 1 << 16);
+
+    removeFiles(path);
+    return missmatch;
+}
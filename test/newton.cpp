@@ -0,0 +1,68 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+std::vector<NewtonSolution> solve(const std::vector<std::string>& equations, const std::vector<std::vector<double>>& starts) {
+    std::vector<Expression*> expressions;
+    for (const std::string& equation : equations) {
+        expressions.push_back(Parser::parse(equation));
+    }
+
+    std::vector<NewtonSolution> solutions = NonlinearSystem(expressions, {Variable("x"), Variable("y")}).solve(starts);
+
+    for (Expression* expr : expressions) {
+        delete expr;
+    }
+
+    return solutions;
+}
+
+bool checkSolution(const NewtonSolution& solution, double x, double y) {
+    return solution.converged && !solution.stalled && std::abs(solution.values.at("x") - x) < 1e-10 && std::abs(solution.values.at("y") - y) < 1e-10;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // intersections of the circle x^2+y^2=4 with the line x=y. The jacobian is singular at the origin
+    const double root = std::sqrt(2.0);
+    std::vector<NewtonSolution> solutions = solve({"x^2+y^2-4", "x-y"}, {{1, 1}, {-1, -3}, {5, 0.5}, {0, 0}});
+
+    if (solutions.size() != 4) {
+        std::cout << "expected 4 solutions got: " << solutions.size() << std::endl;
+        return 1;
+    }
+
+    if (!checkSolution(solutions[0], root, root) || !checkSolution(solutions[1], -root, -root) || !checkSolution(solutions[2], root, root)) {
+        std::cout << "wrong intersection of circle and line" << std::endl;
+        missmatch = true;
+    }
+
+    if (solutions[3].converged) {
+        std::cout << "solution from a singular starting point is reported as converged" << std::endl;
+        missmatch = true;
+    }
+
+    // x^2+1 has no real root, the iteration does not converge
+    solutions = solve({"x^2+1", "y-1"}, {{0.5, 0}});
+    if (solutions[0].converged) {
+        std::cout << "solution of x^2+1=0 is reported as converged" << std::endl;
+        missmatch = true;
+    }
+
+    // the residual can not be evaluated below the tolerance, the iteration stalls
+    solutions = solve({"10^20*(x^2-2)", "y-1"}, {{1, 0}});
+    if (solutions[0].converged || !solutions[0].stalled) {
+        std::cout << "stalled iteration with residual " << solutions[0].residual << " is not reported as stalled" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
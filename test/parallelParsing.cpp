@@ -0,0 +1,91 @@
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+bool checkParallelParsing(const std::string& str) {
+    Expression* sequential = Parser::parse(str);
+    Expression* parallel = Parser::parseParallel(str);
+
+    bool missmatch = false;
+    if (!equalExpressions(sequential, parallel)) {
+        std::cout << "parallel parsing of " << str.substr(0, 80) << " differs from the sequential parser" << std::endl;
+        missmatch = true;
+    }
+
+    delete sequential;
+    delete parallel;
+    return missmatch;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    missmatch |= checkParallelParsing("x");
+    missmatch |= checkParallelParsing("-x+2*y-3");
+    missmatch |= checkParallelParsing("x-2+x");
+    missmatch |= checkParallelParsing("sin(x-2)*(y+1)-e^(x+y)+-z");
+
+    std::string sum;
+    for (int i = 0; i < 2000; i++) {
+        sum += (i % 3 == 0 ? "-" : "+") + std::to_string(i) + "*x^" + std::to_string(i % 7) + "*(y-" + std::to_string(i) + ")";
+    }
+    missmatch |= checkParallelParsing(sum);
+
+    // errors are reported like by the sequential parser
+    try {
+        delete Parser::parseParallel("x+y+");
+        std::cout << "parsing x+y+ did not fail" << std::endl;
+        missmatch = true;
+    }
+    catch (const std::runtime_error&) {
+    }
+
+    // a parse that is cancelled while the summands are parsed frees the terms that were already parsed
+    std::string large;
+    for (int i = 0; i < 200000; i++) {
+        large += (i > 0 ? "+" : "") + std::to_string(i) + "*x^" + std::to_string(i % 7) + "*sin(y+" + std::to_string(i) + ")";
+    }
+
+    CancellationToken token;
+    ResourceBudget budget(ResourceLimits{});
+    std::atomic<bool> finished = false;
+    std::thread canceller([&]() {
+        while (budget.getNodes() < 1000 && !finished) {
+            std::this_thread::yield();
+        }
+        token.cancel();
+    });
+
+    bool cancelled = false;
+    {
+        CancellationScope cancellationScope(token);
+        BudgetScope budgetScope(&budget);
+        try {
+            delete Parser::parse(large);
+        }
+        catch (const operation_cancelled_error&) {
+            cancelled = true;
+        }
+    }
+    finished = true;
+    canceller.join();
+
+    if (!cancelled) {
+        std::cout << "the parse of a large input was not cancelled" << std::endl;
+        missmatch = true;
+    }
+
+    if (budget.getNodes() != 0) {
+        std::cout << "the cancelled parse leaked " << budget.getNodes() << " nodes" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
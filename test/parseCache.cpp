@@ -0,0 +1,89 @@
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "io/parseCache.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+bool checkStatistics(const ParseCache& cache, const std::string& step, size_t hits, size_t misses, size_t entries) {
+    const ParseCache::Statistics statistics = cache.getStatistics();
+    if (statistics.hits != hits || statistics.misses != misses || statistics.entries != entries) {
+        std::cout << "wrong statistics after " << step << std::endl;
+        std::cout << "expected: " << hits << " hits, " << misses << " misses, " << entries << " entries" << std::endl;
+        std::cout << "got:      " << statistics.hits << " hits, " << statistics.misses << " misses, " << statistics.entries << " entries" << std::endl;
+        return true;
+    }
+
+    if (statistics.bytes > statistics.capacity) {
+        std::cout << "the cache uses " << statistics.bytes << " of " << statistics.capacity << " bytes after " << step << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // a hit returns the shared expression, copies are independent of it
+    ParseCache cache;
+    const math::FrozenExpression first = cache.parse("x^2+1");
+    const math::FrozenExpression second = cache.parse("x^2+1");
+    missmatch |= checkStatistics(cache, "parsing the same text twice", 1, 1, 1);
+
+    if (first.get() != second.get()) {
+        std::cout << "a hit does not return the cached expression" << std::endl;
+        missmatch = true;
+    }
+
+    std::unique_ptr<math::Expression> copy(cache.parseCopy("x^2+1"));
+    if (copy.get() == first.get() || copy->toString() != first->toString()) {
+        std::cout << "parseCopy does not return a copy of the cached expression" << std::endl;
+        missmatch = true;
+    }
+    missmatch |= checkStatistics(cache, "copying a cached expression", 2, 1, 1);
+
+    // invalid texts are not cached
+    try {
+        cache.parse("x^");
+        std::cout << "an invalid expression was parsed" << std::endl;
+        missmatch = true;
+    }
+    catch (const std::exception&) {
+    }
+    missmatch |= checkStatistics(cache, "parsing an invalid text", 2, 2, 1);
+
+    // the capacity holds two entries of the same size, the least recently used one is evicted
+    const size_t entrySize = cache.getStatistics().bytes;
+    ParseCache boundedCache(2 * entrySize + entrySize / 2);
+    boundedCache.parse("x^2+1");
+    boundedCache.parse("y^2+1");
+    boundedCache.parse("x^2+1");
+    boundedCache.parse("z^2+1");
+    missmatch |= checkStatistics(boundedCache, "filling the cache", 1, 3, 2);
+
+    boundedCache.parse("x^2+1");
+    missmatch |= checkStatistics(boundedCache, "parsing a recently used text", 2, 3, 2);
+    boundedCache.parse("y^2+1");
+    missmatch |= checkStatistics(boundedCache, "parsing an evicted text", 2, 4, 2);
+
+    // a smaller capacity evicts entries at once
+    boundedCache.setCapacity(entrySize);
+    missmatch |= checkStatistics(boundedCache, "reducing the capacity", 2, 4, 1);
+    boundedCache.parse("y^2+1");
+    missmatch |= checkStatistics(boundedCache, "parsing the remaining text", 3, 4, 1);
+
+    // expressions larger than the capacity are parsed, but not cached
+    boundedCache.parse("x^2+y^2+z^2+1");
+    missmatch |= checkStatistics(boundedCache, "parsing a large text", 3, 5, 1);
+
+    // a capacity of zero disables the cache
+    ParseCache disabledCache(0);
+    disabledCache.parse("x^2+1");
+    disabledCache.parse("x^2+1");
+    missmatch |= checkStatistics(disabledCache, "parsing without cache", 0, 2, 0);
+
+    return missmatch;
+}
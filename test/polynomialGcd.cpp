@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+struct GcdTest {
+    std::string left;
+    std::string right;
+    std::string expected;
+};
+
+std::vector<GcdTest> gcdTests = {
+    {"x^2-1", "x^2+2*x+1", "x+1"},
+    {"6*x^2*y+6*x*y^2", "4*x*y+4*y^2", "2*x*y+2*y^2"},
+    {"(x+y+z)^3*(x-y)*(z+1)", "(x+y+z)^2*(x+2)*(z+1)^2", "(x+y+z)^2*(z+1)"},
+    {"(3*x*y-7*z^2+11)^2*(x^3-y)", "(3*x*y-7*z^2+11)*(x^3+y)", "3*x*y-7*z^2+11"},
+    {"x^4-y^4", "x^3*y-x*y^3", "x^2-y^2"},
+    {"x+1", "x+2", "1"}};
+
+std::vector<std::pair<std::string, std::string>> cancelTests = {
+    {"(x^2-1)/(x-1)", "x+1"},
+    {"(x^2*y-y)/(x*y+y)", "x-1"},
+    {"(sin(x)^2-1)/(sin(x)+1)", "sin(x)-1"},
+    {"1/x+1/y", "(x+y)/(x*y)"},
+    {"x/2+x/2", "x"}};
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    for (const auto& [left, right, expected] : gcdTests) {
+        Expression* leftExpr = Parser::parse(left);
+        Expression* rightExpr = Parser::parse(right);
+        Expression* expectedExpr = Parser::parse(expected);
+
+        Expression* result = polynomialGcd(leftExpr, rightExpr);
+        Expression* normalizedExpected = cancel(expectedExpr);
+
+        if (result->toString() != normalizedExpected->toString()) {
+            std::cout << "gcd[" << left << "," << right << "] expected: " << normalizedExpected->toString() << " got: " << result->toString() << std::endl;
+            missmatch = true;
+        }
+
+        delete leftExpr;
+        delete rightExpr;
+        delete expectedExpr;
+        delete result;
+        delete normalizedExpected;
+    }
+
+    for (const auto& [input, expected] : cancelTests) {
+        Expression* expr = Parser::parse(input);
+        Expression* result = cancel(expr);
+
+        if (result->toString() != expected) {
+            std::cout << "cancel[" << input << "] expected: " << expected << " got: " << result->toString() << std::endl;
+            missmatch = true;
+        }
+
+        delete expr;
+        delete result;
+    }
+
+    return missmatch;
+}
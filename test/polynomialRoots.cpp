@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // roots of x^2-3x+2
+    Expression* expr = Parser::parse("x^2-3*x+2");
+    std::vector<PolynomialRoot> result = roots(expr, Variable("x"));
+    delete expr;
+
+    if (result.size() != 2 || std::abs(result[0].value.realValue - 1) > 1e-12 || std::abs(result[1].value.realValue - 2) > 1e-12) {
+        std::cout << "roots of x^2-3*x+2 are wrong" << std::endl;
+        missmatch = true;
+    }
+
+    // the roots of unity of high degree are computed in parallel
+    const int degree = 256;
+    std::vector<double> coefficients(degree + 1, 0);
+    coefficients[0] = -1;
+    coefficients[degree] = 1;
+
+    result = findRoots(coefficients);
+    if (result.size() != degree) {
+        std::cout << "expected " << degree << " roots got: " << result.size() << std::endl;
+        missmatch = true;
+    }
+
+    for (const PolynomialRoot& root : result) {
+        if (!root.converged || std::abs(root.value.abs() - 1) > 1e-10) {
+            std::cout << "root " << root.value.toString() << " is not a root of unity" << std::endl;
+            missmatch = true;
+        }
+    }
+
+    // the roots are reported as not converged if the iterations are not enough
+    result = findRoots({-1, 0, 0, 0, 0, 1}, 1e-14, 1);
+    if (std::any_of(result.begin(), result.end(), [](const PolynomialRoot& root) { return root.converged; })) {
+        std::cout << "roots after one iteration are reported as converged" << std::endl;
+        missmatch = true;
+    }
+
+    // the iteration stalls at a multiple root long before the tolerance is reached
+    result = findRoots({-1, 3, -3, 1});
+    if (result.size() != 3 || std::any_of(result.begin(), result.end(), [](const PolynomialRoot& root) { return root.converged; })) {
+        std::cout << "roots of (x-1)^3 are reported as converged" << std::endl;
+        missmatch = true;
+    }
+
+    // constant polynomials have no roots
+    expr = Parser::parse("5");
+    result = roots(expr, Variable("x"));
+    delete expr;
+
+    if (!result.empty()) {
+        std::cout << "expected no roots of a constant got: " << result.size() << std::endl;
+        missmatch = true;
+    }
+
+    // powers are not expanded beyond the maximum degree
+    expr = Parser::parse("x^3000000");
+    try {
+        roots(expr, Variable("x"));
+        std::cout << "x^3000000 was expanded" << std::endl;
+        missmatch = true;
+    } catch (const std::runtime_error&) {
+    }
+    delete expr;
+
+    return missmatch;
+}
@@ -0,0 +1,62 @@
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+bool checkSeries(const std::string& exprStr, double x0, const std::vector<double>& expected) {
+    Expression* expr = Parser::parse(exprStr);
+    PowerSeries result = taylorSeries(expr, Variable("x"), x0, expected.size() - 1);
+    delete expr;
+
+    for (size_t k = 0; k < expected.size(); k++) {
+        if (std::abs(result[k] - expected[k]) > 1e-12) {
+            std::cout << "coefficient " << k << " of the series of " << exprStr << " is wrong" << std::endl;
+            std::cout << "expected: " << expected[k] << std::endl;
+            std::cout << "got:      " << result[k] << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// the coefficients are printed as numbers, which have to be read back to the same value
+bool checkNumberRoundTrip(double value) {
+    const Number number(value);
+    Expression* parsed = Parser::parse(number.toString());
+    const double parsedValue = parsed->getValue().realValue;
+    delete parsed;
+
+    if (parsedValue != value) {
+        std::cout << "number " << number.toString() << " is read back as " << parsedValue << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    missmatch |= checkSeries("e^x", 0, {1, 1, 1.0 / 2, 1.0 / 6, 1.0 / 24});
+    missmatch |= checkSeries("sin(x)*cos(x)", 0, {0, 1, 0, -2.0 / 3, 0, 2.0 / 15});
+    missmatch |= checkSeries("ln(x)", 1, {0, 1, -1.0 / 2, 1.0 / 3, -1.0 / 4});
+    missmatch |= checkSeries("(1+x)^(1/2)", 0, {1, 1.0 / 2, -1.0 / 8, 1.0 / 16});
+    missmatch |= checkSeries("arctan(x)", 0, {0, 1, 0, -1.0 / 3, 0, 1.0 / 5});
+    missmatch |= checkSeries("1/(1-x)", 0, {1, 1, 1, 1, 1});
+
+    missmatch |= checkNumberRoundTrip(0.00001);
+    missmatch |= checkNumberRoundTrip(1.0 / 6);
+    missmatch |= checkNumberRoundTrip(-2.5e-12);
+    missmatch |= checkNumberRoundTrip(1e-300);
+    missmatch |= checkNumberRoundTrip(6.02214076e23);
+    missmatch |= checkNumberRoundTrip(1.7976931348623157e308);
+
+    return missmatch;
+}
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/engine.hpp"
+#include "io/protocol.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::vector<std::string> getLines(const std::string& str) {
+    std::vector<std::string> lines;
+    std::stringstream stream(str);
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        lines.push_back(line);
+    }
+
+    return lines;
+}
+
+// the position of the response to the request or the number of responses if there is none
+size_t findResponse(const std::vector<std::string>& responses, const std::string& id) {
+    for (size_t i = 0; i < responses.size(); i++) {
+        if (responses[i].starts_with(id + " "))
+            return i;
+    }
+
+    return responses.size();
+}
+
+bool checkResponse(const std::vector<std::string>& responses, const std::string& id, const std::string& expected) {
+    const size_t position = findResponse(responses, id);
+    if (position == responses.size() || responses[position] != expected) {
+        std::cout << "wrong response to request " << id << std::endl;
+        std::cout << "expected: " << expected << std::endl;
+        std::cout << "got:      " << (position == responses.size() ? "no response" : responses[position]) << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+bool checkOrder(const std::vector<std::string>& responses, const std::string& first, const std::string& second) {
+    if (findResponse(responses, first) >= findResponse(responses, second)) {
+        std::cout << "the response to request " << first << " is not sent before the response to " << second << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // the derivative of a long sum takes much longer than the other requests
+    std::string large;
+    for (int i = 1; i < 5000; i++) {
+        large += (i > 1 ? "+" : "") + std::to_string(i) + "*x^" + std::to_string(i) + "*y^" + std::to_string(i % 13);
+    }
+
+    std::stringstream input;
+    input << "slow D[" << large << ", x]\n";
+    input << "fast simplify[1+1]\n";
+    input << "set a=5\n";
+    input << "get simplify[a+1];\n";
+    input << "failed foo[x]\n";
+    input << "empty  \n";
+    input << "\n";
+    input << "lines roots[x^2-1, x]\n";
+
+    std::stringstream output;
+    int status;
+    {
+        Engine engine;
+        Protocol protocol(engine, input, output, 4);
+        status = protocol.run();
+    }
+
+    const std::vector<std::string> responses = getLines(output.str());
+    if (responses.size() != 7) {
+        std::cout << "expected 7 responses, got " << responses.size() << std::endl;
+        missmatch = true;
+    }
+
+    // independent requests are answered as soon as they are finished
+    missmatch |= checkResponse(responses, "fast", "fast ok 2");
+    missmatch |= checkOrder(responses, "fast", "slow");
+
+    if (findResponse(responses, "slow") == responses.size() || !responses[findResponse(responses, "slow")].starts_with("slow ok ")) {
+        std::cout << "the slow request failed" << std::endl;
+        missmatch = true;
+    }
+
+    // an assignment waits for the running requests, the following requests see the new value
+    missmatch |= checkResponse(responses, "set", "set ok 5");
+    missmatch |= checkOrder(responses, "slow", "set");
+    missmatch |= checkResponse(responses, "get", "get ok 6");
+    missmatch |= checkOrder(responses, "set", "get");
+
+    // errors and outputs of several lines
+    missmatch |= checkResponse(responses, "failed", "failed error Command \"foo\" not found!");
+    missmatch |= checkResponse(responses, "empty", "empty error The request contains no command");
+    missmatch |= checkResponse(responses, "lines", "lines ok -1\\n1");
+
+    if (status != 1) {
+        std::cout << "the protocol did not report the failed requests" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
@@ -0,0 +1,154 @@
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/parser.hpp"
+
+using namespace cas;
+using namespace cas::io;
+using namespace cas::math;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+bool checkOutput(Engine& engine, const std::string& command, const std::string& expected) {
+    const std::string output = execute(engine, command);
+    if (output != expected) {
+        std::cout << "wrong output of " << command << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << output;
+        return true;
+    }
+
+    return false;
+}
+
+std::string nest(const std::string& expression, size_t depth) {
+    return std::string(depth, '(') + expression + std::string(depth, ')');
+}
+
+// runs the computation under a budget with the given limits. It has to fail with the message and must not leave any
+// node charged to the budget
+bool checkLimit(const std::string& name, const ResourceLimits& limits, const std::string& message, const std::function<void()>& compute) {
+    ResourceBudget budget(limits);
+    std::string error;
+    {
+        BudgetScope scope(&budget);
+        try {
+            compute();
+        }
+        catch (const resource_limit_error& e) {
+            error = e.what();
+        }
+    }
+
+    if (error != message) {
+        std::cout << name << " failed with \"" << error << "\" instead of \"" << message << "\"" << std::endl;
+        return true;
+    }
+
+    if (budget.getNodes() != 0 || budget.getBytes() != 0) {
+        std::cout << name << " left " << budget.getNodes() << " nodes and " << budget.getBytes() << " bytes charged to the budget" << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+// the expression grows with every derivative until the limit is reached
+void differentiateRepeatedly(const std::string& expression, bool operatorD) {
+    const Variable x("x");
+    std::unique_ptr<Expression> expr(Parser::parse(expression));
+    for (int i = 0; i < 100; i++) {
+        expr.reset(operatorD ? D(expr.get(), x) : expr->differentiate(&x));
+    }
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // repeated derivatives stop at the node and byte limits, the partial results are freed
+    for (const std::string expression : {"x^3*sin(x)", "x^x", "ln(x)*cos(x)+tan(x)"}) {
+        for (bool operatorD : {true, false}) {
+            const std::string name = std::string(operatorD ? "D" : "differentiate") + " of " + expression;
+            for (size_t maxNodes : {20, 150, 1000, 5000}) {
+                missmatch |= checkLimit(name, {maxNodes, 0, 0}, "The command exceeded the limit of " + std::to_string(maxNodes) + " expression nodes", [&]() {
+                    differentiateRepeatedly(expression, operatorD);
+                });
+            }
+            missmatch |= checkLimit(name, {0, 100000, 0}, "The command exceeded the limit of 100000 bytes", [&]() {
+                differentiateRepeatedly(expression, operatorD);
+            });
+        }
+    }
+
+    // deeply nested input stops at the depth limit
+    missmatch |= checkLimit("parsing nested input", {0, 0, 100}, "The command exceeded the recursion depth of 100", []() {
+        delete Parser::parse(nest("x", 500) + "+1");
+    });
+    missmatch |= checkLimit("differentiating a deep expression", {0, 0, 100}, "The command exceeded the recursion depth of 100", []() {
+        std::unique_ptr<Expression> expr;
+        {
+            BudgetScope unlimited(nullptr);
+            expr.reset(Parser::parse("x"));
+            for (int i = 0; i < 500; i++) {
+                expr.reset(new Multiplication(expr.release(), new Variable("y")));
+            }
+        }
+        const Variable x("x");
+        delete expr->differentiate(&x);
+    });
+
+    // the depth is restored after the error, so the next computation under the same budget gets the full depth
+    ResourceBudget budget({0, 0, 100});
+    {
+        BudgetScope scope(&budget);
+        try {
+            delete Parser::parse(nest("x", 500));
+        }
+        catch (const resource_limit_error&) {
+        }
+
+        try {
+            std::unique_ptr<Expression> expr(Parser::parse(nest("x", 20)));
+        }
+        catch (const resource_limit_error& e) {
+            std::cout << "the depth was not restored after the error: " << e.what() << std::endl;
+            missmatch = true;
+        }
+    }
+
+    // the engine reports the exceeded limit and keeps working
+    Engine engine;
+    execute(engine, "f=x^x*sin(x)^x*ln(x)*tan(x)");
+    missmatch |= checkOutput(engine, "limits[30, 0, 0]", "limits set to 30 nodes, 0 bytes, depth 0\n");
+    missmatch |= checkOutput(engine, "D[f, x]", "The command exceeded the limit of 30 expression nodes\n");
+    missmatch |= checkOutput(engine, "simplify[1+1]", "2\n");
+
+    missmatch |= checkOutput(engine, "limits[0, 1000, 0]", "limits set to 0 nodes, 1000 bytes, depth 0\n");
+    missmatch |= checkOutput(engine, "D[f, x]", "The command exceeded the limit of 1000 bytes\n");
+    missmatch |= checkOutput(engine, "simplify[1+1]", "2\n");
+
+    missmatch |= checkOutput(engine, "limits[0, 0, 50]", "limits set to 0 nodes, 0 bytes, depth 50\n");
+    missmatch |= checkOutput(engine, "simplify[" + nest("x", 100) + "]", "The command exceeded the recursion depth of 50\n");
+    missmatch |= checkOutput(engine, "simplify[" + nest("x", 10) + "+x]", "2*x\n");
+
+    // without limits the same command succeeds
+    missmatch |= checkOutput(engine, "limits[0, 0, 0]", "limits set to 0 nodes, 0 bytes, depth 0\n");
+    if (execute(engine, "D[f, x]").starts_with("The command exceeded")) {
+        std::cout << "the limits were not removed" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
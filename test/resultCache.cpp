@@ -0,0 +1,54 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+// the commands are executed in order with and without the cache, the cache must not change any result
+bool checkCachedResults(const std::vector<std::string>& commands) {
+    Engine cachedEngine;
+    Engine uncachedEngine;
+    uncachedEngine.setCacheCapacity(0);
+
+    for (const std::string& command : commands) {
+        const std::string cached = execute(cachedEngine, command);
+        const std::string uncached = execute(uncachedEngine, command);
+
+        if (cached != uncached) {
+            std::cout << "cached result of " << command << " differs" << std::endl;
+            std::cout << "expected: " << uncached;
+            std::cout << "got:      " << cached;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // whitespaces around the arguments
+    missmatch |= checkCachedResults({"D[x^2, x]", "D[x^2,x]", "D[ x^2 ,x ]"});
+    missmatch |= checkCachedResults({"simplify[ x+x ]", "simplify[x+x]"});
+    missmatch |= checkCachedResults({"series[e^x, x, 0, 3]", "series[e^x,x,0,3]"});
+
+    // changed variables
+    missmatch |= checkCachedResults({"a=2", "D[a*x^2,x]", "a=3", "D[a*x^2,x]", "D[[a*x, x^2], x]", "D[[a*x,x^2],x]"});
+
+    return missmatch;
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mathlib/mathlib.hpp>
+#include <parallel/ringBuffer.hpp>
+
+using namespace cas::math;
+
+struct Record {
+    size_t producer = 0;
+    size_t sequence = 0;
+};
+
+// every producer pushes its records in order and retries if the buffer is full. The consumer has to receive every
+// record exactly once and the records of each producer in order
+bool checkProducers(size_t producerCount, size_t recordCount, size_t capacity) {
+    RingBuffer<Record> buffer(capacity);
+
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < producerCount; producer++) {
+        producers.emplace_back([&buffer, producer, recordCount]() {
+            for (size_t i = 0; i < recordCount; i++) {
+                while (!buffer.push(Record{producer, i})) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    bool missmatch = false;
+    std::vector<size_t> next(producerCount, 0);
+    size_t received = 0;
+    Record record;
+    while (received < producerCount * recordCount) {
+        if (!buffer.pop(record)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (record.producer >= producerCount || record.sequence != next[record.producer]) {
+            if (!missmatch) {
+                std::cout << "received record " << record.sequence << " of producer " << record.producer << " out of order" << std::endl;
+            }
+            missmatch = true;
+        }
+        else {
+            next[record.producer]++;
+        }
+        received++;
+    }
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    if (buffer.pop(record)) {
+        std::cout << "the buffer contains more records than were pushed" << std::endl;
+        missmatch = true;
+    }
+
+    return missmatch;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // the capacity is rounded up to a power of two
+    if (RingBuffer<int>(5).getCapacity() != 8 || RingBuffer<int>(8).getCapacity() != 8 || RingBuffer<int>(0).getCapacity() != 2) {
+        std::cout << "the capacity is not rounded up to a power of two" << std::endl;
+        missmatch = true;
+    }
+
+    // a full buffer rejects new elements until the consumer removes one
+    RingBuffer<std::string> buffer(4);
+    for (int i = 0; i < 4; i++) {
+        if (!buffer.push(std::to_string(i))) {
+            std::cout << "element " << i << " was rejected by a buffer that is not full" << std::endl;
+            missmatch = true;
+        }
+    }
+
+    if (buffer.push("4")) {
+        std::cout << "a full buffer accepted an element" << std::endl;
+        missmatch = true;
+    }
+
+    std::string value;
+    if (!buffer.pop(value) || value != "0" || !buffer.push("4")) {
+        std::cout << "the buffer does not accept an element after one was removed" << std::endl;
+        missmatch = true;
+    }
+
+    for (const std::string expected : {"1", "2", "3", "4"}) {
+        if (!buffer.pop(value) || value != expected) {
+            std::cout << "expected " << expected << " got " << value << std::endl;
+            missmatch = true;
+        }
+    }
+
+    if (buffer.pop(value)) {
+        std::cout << "an empty buffer returned an element" << std::endl;
+        missmatch = true;
+    }
+
+    // the positions wrap around many times
+    missmatch |= checkProducers(1, 100000, 4);
+
+    // stress test with several producers on a small and a large buffer
+    const size_t producerCount = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+    missmatch |= checkProducers(producerCount, 50000, 16);
+    missmatch |= checkProducers(producerCount, 50000, 4096);
+
+    return missmatch;
+}
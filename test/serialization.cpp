@@ -0,0 +1,95 @@
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+bool checkRoundTrip(Expression* expr) {
+    const std::string encoded = encodeExpression(expr);
+    Expression* decoded = decodeExpression(encoded);
+
+    bool missmatch = false;
+    if (!equalExpressions(expr, decoded)) {
+        std::cout << "decoded " << decoded->toString() << " differs from " << expr->toString() << std::endl;
+        missmatch = true;
+    }
+
+    delete decoded;
+    delete expr;
+    return missmatch;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    missmatch |= checkRoundTrip(Parser::parse("x^2*sin(x)+ln(y)/cosh(x*y)-3"));
+    missmatch |= checkRoundTrip(Parser::parse("e^(i*pi)+arctan(x)^x"));
+    // numbers are stored with all bits
+    missmatch |= checkRoundTrip(new Addition(new Number(0.1 + 1e-17), new Complex(1.0 / 3, -2.5)));
+    missmatch |= checkRoundTrip(new Multiplication(new Differential("x"), new Variable("y")));
+
+    // several expressions in one stream share the symbol table
+    std::ostringstream stream(std::ios::binary);
+    ExpressionWriter writer(stream);
+    Expression* first = Parser::parse("x*y+sin(x)");
+    Expression* second = Parser::parse("sin(y)*x");
+    writer.write(first);
+    writer.write(second);
+
+    const std::string data = stream.str();
+    ExpressionReader reader(data);
+    Expression* firstRead = reader.read();
+    Expression* secondRead = reader.read();
+    if (!reader.atEnd() || !equalExpressions(first, firstRead) || !equalExpressions(second, secondRead)) {
+        std::cout << "the stream of two expressions was not read correctly" << std::endl;
+        missmatch = true;
+    }
+
+    // truncated data is rejected
+    try {
+        delete decodeExpression(std::string_view(data).substr(0, data.size() - 2));
+        std::cout << "truncated data was accepted" << std::endl;
+        missmatch = true;
+    }
+    catch (const serialization_error&) {
+    }
+
+    // snapshots
+    const std::string path = "serialization_test.snap";
+    SnapshotWriter snapshotWriter;
+    snapshotWriter.add("f", first);
+    snapshotWriter.add("g", second);
+    snapshotWriter.write(path);
+
+    {
+        Snapshot snapshot(path);
+        if (snapshot.getRootCount() != 2 || snapshot.getName(0) != "f" || snapshot.getName(1) != "g") {
+            std::cout << "the roots of the snapshot are wrong" << std::endl;
+            missmatch = true;
+        }
+        else {
+            Expression* f = snapshot.load(0);
+            Expression* g = snapshot.load(1);
+            if (!equalExpressions(first, f) || !equalExpressions(second, g)) {
+                std::cout << "the expressions of the snapshot are wrong" << std::endl;
+                missmatch = true;
+            }
+
+            delete f;
+            delete g;
+        }
+    }
+    std::remove(path.c_str());
+
+    delete first;
+    delete second;
+    delete firstRead;
+    delete secondRead;
+
+    return missmatch;
+}
@@ -0,0 +1,188 @@
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "io/server.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace cas;
+using namespace cas::io;
+
+sockaddr_un makeAddress(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+
+    return address;
+}
+
+// a session of the server. Requests are terminated by ';', every response by a null character
+class Client {
+  protected:
+    int socket = -1;
+    std::string received;
+
+  public:
+    Client(const std::string& path) {
+        socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+        const sockaddr_un address = makeAddress(path);
+        if (connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+            throw std::runtime_error("Cannot connect to " + path);
+
+        // a missing response fails the test instead of blocking it
+        timeval timeout{10, 0};
+        setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    Client(const Client& other) = delete;
+
+    ~Client() {
+        close(socket);
+    }
+
+    void send(const std::string& str) {
+        ::send(socket, str.data(), str.size(), MSG_NOSIGNAL);
+    }
+
+    std::string receive() {
+        size_t end;
+        while ((end = received.find('\0')) == std::string::npos) {
+            char buffer[4096];
+            const ssize_t count = recv(socket, buffer, sizeof(buffer), 0);
+            if (count <= 0)
+                return "no response";
+
+            received.append(buffer, count);
+        }
+
+        const std::string response = received.substr(0, end);
+        received.erase(0, end + 1);
+        return response;
+    }
+};
+
+bool checkResponse(Client& client, const std::string& request, const std::string& expected) {
+    client.send(request);
+    const std::string response = client.receive();
+    if (response != expected) {
+        std::cout << "wrong response to " << request << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << response << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+bool checkRefused(const std::string& path, const std::string& situation) {
+    try {
+        Server server(path, 1);
+        std::cout << "the server listens on " << path << " " << situation << std::endl;
+        return true;
+    }
+    catch (const std::runtime_error& e) {
+        if (std::string(e.what()) != "Cannot listen on " + path + ": address in use") {
+            std::cout << "wrong error " << situation << ": " << e.what() << std::endl;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    const std::string path = (std::filesystem::temp_directory_path() / ("cas_server_test_" + std::to_string(getpid()) + ".sock")).string();
+
+    // the socket of a server that was not shut down cleanly is reused
+    {
+        const int stale = socket(AF_UNIX, SOCK_STREAM, 0);
+        const sockaddr_un address = makeAddress(path);
+        bind(stale, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        close(stale);
+    }
+
+    if (!std::filesystem::is_socket(path)) {
+        std::cout << "the stale socket was not created" << std::endl;
+        return true;
+    }
+
+    {
+        Server server(path, 2);
+
+        // the address of a running server is refused
+        missmatch |= checkRefused(path, "of a running server");
+
+        std::thread serverThread(&Server::run, &server);
+
+        {
+            Client first(path);
+            Client second(path);
+
+            // every session has its own variables
+            missmatch |= checkResponse(first, "a=1;", "1\n");
+            missmatch |= checkResponse(second, "a;", "Command \"a\" not found!\n");
+            missmatch |= checkResponse(second, "a=5;", "5\n");
+            missmatch |= checkResponse(first, "a;", "1\n");
+            missmatch |= checkResponse(second, "simplify[a+1];", "6\n");
+
+            // and its own ans
+            missmatch |= checkResponse(first, "simplify[a+1];", "2\n");
+            missmatch |= checkResponse(second, "ans;", "6\n");
+            missmatch |= checkResponse(first, "ans;", "2\n");
+
+            // a request can be split over several writes and is only executed when its ';' arrives
+            first.send("simpl");
+            first.send("ify[2");
+            missmatch |= checkResponse(first, "+2];", "4\n");
+
+            // several requests in one write get one response each, the output of a request can have several lines
+            first.send("simplify[3+3]; roots[x^2-1, x];; ");
+            const std::string responses[] = {first.receive(), first.receive()};
+            if (responses[0] != "6\n" || responses[1] != "-1\n1\n") {
+                std::cout << "wrong responses to two requests in one write: " << responses[0] << " and " << responses[1] << std::endl;
+                missmatch = true;
+            }
+
+            // the empty request is not answered, the next response belongs to the next request
+            missmatch |= checkResponse(first, "simplify[4+4];", "8\n");
+        }
+
+        // a session that exits is closed by the server
+        {
+            Client client(path);
+            missmatch |= checkResponse(client, "exit;", "shutting down!\n");
+            if (client.receive() != "no response") {
+                std::cout << "the session was not closed after exit" << std::endl;
+                missmatch = true;
+            }
+        }
+
+        std::raise(SIGTERM);
+        serverThread.join();
+    }
+
+    if (std::filesystem::exists(path)) {
+        std::cout << "the socket was not removed when the server stopped" << std::endl;
+        missmatch = true;
+    }
+
+    // other files are never replaced
+    std::ofstream(path) << "data";
+    missmatch |= checkRefused(path, "of a regular file");
+    if (!std::filesystem::is_regular_file(path)) {
+        std::cout << "a regular file at the socket path was removed" << std::endl;
+        missmatch = true;
+    }
+    std::filesystem::remove(path);
+
+    return missmatch;
+}
@@ -0,0 +1,51 @@
+#include <iostream>
+#include <string>
+
+#include "io/parser.hpp"
+#include <mathlib/mathlib.hpp>
+
+using namespace cas::math;
+using namespace cas::io;
+
+bool checkSimplify(const std::string& exprStr, const std::string& expected) {
+    Expression* expr = Parser::parse(exprStr);
+    Expression* simplified = expr->simplify();
+    const std::string result = simplified->toString();
+
+    delete expr;
+    delete simplified;
+
+    if (result != expected) {
+        std::cout << "simplification of " << exprStr << " is wrong" << std::endl;
+        std::cout << "expected: " << expected << std::endl;
+        std::cout << "got:      " << result << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    missmatch |= checkSimplify("x+x+2*x+3-3", "4*x");
+    missmatch |= checkSimplify("0*y+x*1", "x");
+    missmatch |= checkSimplify("x*x*y^2*y^(-1)*3*2", "6*x^2*y");
+    missmatch |= checkSimplify("2^3+x^0", "9");
+    missmatch |= checkSimplify("x-x", "0");
+
+    // the 300 terms of the sum have enough nodes to be simplified in parallel
+    std::string sum;
+    std::string expected = "3";
+    for (int k = 0; k < 3; k++) {
+        for (int i = 0; i < 100; i++) {
+            sum += (sum.empty() ? "" : "+") + std::string("1*x^") + std::to_string(i);
+        }
+    }
+    for (int i = 1; i < 100; i++) {
+        expected += i == 1 ? "+3*x" : "+3*x^" + std::to_string(i);
+    }
+    missmatch |= checkSimplify(sum, expected);
+
+    return missmatch;
+}
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+// gives access to the progress of the background thread
+class SpeculatingEngine : public Engine {
+  public:
+    SpeculatingEngine() {
+        setSpeculation(true);
+    }
+
+    size_t getCompleted() {
+        return speculator->getCompleted();
+    }
+
+    // waits until the results of the given number of variables were stored
+    bool waitForCompleted(size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+        while (getCompleted() < count) {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        return true;
+    }
+};
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+// the command has to be answered from the cache with the same result as without speculation
+bool checkHit(SpeculatingEngine& engine, Engine& reference, const std::string& command) {
+    const ResultCache::Statistics before = engine.getCacheStatistics();
+    const std::string output = execute(engine, command);
+    const ResultCache::Statistics after = engine.getCacheStatistics();
+
+    const std::string expected = execute(reference, command);
+    if (output != expected) {
+        std::cout << "wrong speculative result of " << command << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << output;
+        return true;
+    }
+
+    if (after.hits != before.hits + 1 || after.misses != before.misses) {
+        std::cout << command << " was not answered from the cache" << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    Engine reference;
+    reference.setSpeculation(false);
+
+    // the results of simplify, D and Df of a new variable are served from the cache
+    SpeculatingEngine engine;
+    for (Engine* e : {static_cast<Engine*>(&engine), &reference}) {
+        execute(*e, "f=x^2*y+x");
+    }
+
+    if (!engine.waitForCompleted(1)) {
+        std::cout << "the speculation did not finish" << std::endl;
+        return true;
+    }
+
+    missmatch |= checkHit(engine, reference, "simplify[f]");
+    missmatch |= checkHit(engine, reference, "D[f, x]");
+    missmatch |= checkHit(engine, reference, "D[f, y]");
+    missmatch |= checkHit(engine, reference, "Df[f]");
+
+    // a new value is speculated again, the results of the old value are not returned
+    for (Engine* e : {static_cast<Engine*>(&engine), &reference}) {
+        execute(*e, "f=x^3*y");
+    }
+
+    if (!engine.waitForCompleted(2)) {
+        std::cout << "the speculation of a new value did not finish" << std::endl;
+        return true;
+    }
+
+    missmatch |= checkHit(engine, reference, "simplify[f]");
+    missmatch |= checkHit(engine, reference, "D[f, x]");
+
+    // a redefinition cancels the speculation of a value that takes seconds, so only the new value is completed
+    SpeculatingEngine cancelledEngine;
+    std::string large;
+    for (int i = 1; i < 5000; i++) {
+        large += (i > 1 ? "+" : "") + std::to_string(i) + "*x^" + std::to_string(i) + "*y^" + std::to_string(i % 13) + "*z^" + std::to_string(i % 5);
+    }
+
+    execute(cancelledEngine, "g=" + large);
+    for (Engine* e : {static_cast<Engine*>(&cancelledEngine), &reference}) {
+        execute(*e, "g=x*z");
+    }
+
+    if (!cancelledEngine.waitForCompleted(1)) {
+        std::cout << "the speculation after a redefinition did not finish" << std::endl;
+        return true;
+    }
+
+    // the old value would be counted when it finishes
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (cancelledEngine.getCompleted() != 1) {
+        std::cout << "the speculation of the old value was not cancelled" << std::endl;
+        missmatch = true;
+    }
+
+    missmatch |= checkHit(cancelledEngine, reference, "D[g, z]");
+
+    return missmatch;
+}
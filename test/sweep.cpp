@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+bool checkOutput(Engine& engine, const std::string& command, const std::string& expected) {
+    const std::string output = execute(engine, command);
+    if (output != expected) {
+        std::cout << "wrong output of " << command << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << output;
+        return true;
+    }
+
+    return false;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    return content.str();
+}
+
+bool checkFile(const std::string& path, const std::string& expected) {
+    const std::string content = readFile(path);
+    if (content != expected) {
+        std::cout << "wrong content of " << path << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << content;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+    Engine engine;
+
+    const std::string csvPath = "sweep_test.csv";
+    const std::string binaryPath = "sweep_test.bin";
+
+    // a single axis
+    missmatch |= checkOutput(engine, "sweep[x^2, " + csvPath + ", x=0:1:3]", "wrote 3 points to " + csvPath + "\n");
+    missmatch |= checkFile(csvPath, "x,value\n0,0\n0.5,0.25\n1,1\n");
+
+    // the variadic ranges span a grid, the last axis changes fastest
+    missmatch |= checkOutput(engine, "sweep[x+y, " + csvPath + ", x=0:1:2, y = 10 : 20 : 2]", "wrote 4 points to " + csvPath + "\n");
+    missmatch |= checkFile(csvPath, "x,y,value\n0,10,10\n0,20,20\n1,10,11\n1,20,21\n");
+
+    // a single point per axis uses the beginning of the range
+    missmatch |= checkOutput(engine, "sweep[x*y, " + csvPath + ", x=2:5:1, y=-1:1:3]", "wrote 3 points to " + csvPath + "\n");
+    missmatch |= checkFile(csvPath, "x,y,value\n2,-1,-2\n2,0,0\n2,1,2\n");
+
+    // the binary output contains the coordinates and the value of every point as doubles
+    missmatch |= checkOutput(engine, "sweep[x^2, " + binaryPath + ", x=1:3:3]", "wrote 3 points to " + binaryPath + "\n");
+    const std::string binary = readFile(binaryPath);
+    const std::vector<double> expectedValues = {1, 1, 2, 4, 3, 9};
+    std::vector<double> values(binary.size() / sizeof(double));
+    std::memcpy(values.data(), binary.data(), values.size() * sizeof(double));
+    if (binary.size() != expectedValues.size() * sizeof(double) || values != expectedValues) {
+        std::cout << "wrong binary output of the sweep" << std::endl;
+        missmatch = true;
+    }
+
+    // the axes are swept even if variables with the same names are defined, the other variables are substituted
+    execute(engine, "x=5");
+    execute(engine, "a=2");
+    missmatch |= checkOutput(engine, "sweep[a*x^2, " + csvPath + ", x=0:1:3]", "wrote 3 points to " + csvPath + "\n");
+    missmatch |= checkFile(csvPath, "x,value\n0,0\n0.5,0.5\n1,2\n");
+    missmatch |= checkOutput(engine, "sweep[x+y, " + csvPath + ", y=0:1:2]", "wrote 2 points to " + csvPath + "\n");
+    missmatch |= checkFile(csvPath, "y,value\n0,5\n1,6\n");
+
+    // invalid ranges
+    missmatch |= checkOutput(engine, "sweep[x, " + csvPath + ", x=0:1]", "The range \"x=0:1\" has to be written as var=begin:end:count\n");
+    missmatch |= checkOutput(engine, "sweep[x, " + csvPath + ", 0:1:2]", "The range \"0:1:2\" has to be written as var=begin:end:count\n");
+    missmatch |= checkOutput(engine, "sweep[x, " + csvPath + ", x=0:1:0]", "The number of points of x has to be a positive integer\n");
+    missmatch |= checkOutput(engine, "sweep[x, " + csvPath + ", x=0:1:2.5]", "The number of points of x has to be a positive integer\n");
+
+    // failed sweeps do not touch an existing file
+    const std::string content = readFile(csvPath);
+    missmatch |= checkOutput(engine, "sweep[x, " + csvPath + "]", "The sweep needs at least one variable\n");
+    execute(engine, "sweep[x+y, " + csvPath + ", x=0:1:2]");
+    missmatch |= checkFile(csvPath, content);
+
+    if (std::filesystem::exists(csvPath + ".tmp")) {
+        std::cout << "the temporary file of a failed sweep was not removed" << std::endl;
+        missmatch = true;
+    }
+
+    std::remove(csvPath.c_str());
+    std::remove(binaryPath.c_str());
+
+    return missmatch;
+}
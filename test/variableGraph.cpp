@@ -0,0 +1,139 @@
+#include <cctype>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "io/engine.hpp"
+#include "io/ioStream.hpp"
+#include "io/parser.hpp"
+#include "io/variableGraph.hpp"
+
+using namespace cas;
+using namespace cas::io;
+
+std::string execute(Engine& engine, const std::string& command) {
+    std::stringstream output;
+    IOStream::setOutput(&output);
+    engine.execute(IOStream::parseCommand(command));
+    IOStream::setOutput(nullptr);
+
+    return output.str();
+}
+
+bool checkOutput(Engine& engine, const std::string& command, const std::string& expected) {
+    const std::string output = execute(engine, command);
+    if (output != expected) {
+        std::cout << "wrong output of " << command << std::endl;
+        std::cout << "expected: " << expected;
+        std::cout << "got:      " << output;
+        return true;
+    }
+
+    return false;
+}
+
+std::string getValue(VariableGraph& graph, const VariableSymbol& symbol) {
+    std::unique_ptr<Expression> value(graph.getValue(symbol));
+    return value->toString();
+}
+
+// resolves the variable and checks its value and the number of values computed for it
+bool checkRecomputations(VariableGraph& graph, const VariableSymbol& symbol, const std::string& expected, size_t recomputations) {
+    const size_t before = graph.getRecomputations();
+    const std::string value = getValue(graph, symbol);
+    const size_t computed = graph.getRecomputations() - before;
+
+    if (value != expected || computed != recomputations) {
+        std::cout << "resolving " << symbol << " gave " << value << " with " << computed << " recomputations" << std::endl;
+        std::cout << "expected " << expected << " with " << recomputations << " recomputations" << std::endl;
+        return true;
+    }
+
+    return false;
+}
+
+int main(int argC, char** argV) {
+    bool missmatch = false;
+
+    // a diamond: b and c depend on a, d depends on both
+    VariableGraph graph;
+    graph.define("a", Parser::parse("x"));
+    graph.define("b", Parser::parse("a+1"));
+    graph.define("c", Parser::parse("a*2"));
+    graph.define("d", Parser::parse("b+c"));
+    graph.define("f", Parser::parse("y"));
+
+    missmatch |= checkRecomputations(graph, "d", "x+1+x*2", 4);
+    missmatch |= checkRecomputations(graph, "f", "y", 1);
+
+    // known values are not computed again
+    missmatch |= checkRecomputations(graph, "d", "x+1+x*2", 0);
+
+    // only the variables downstream of a changed definition are recomputed
+    graph.define("b", Parser::parse("a+3"));
+    missmatch |= checkRecomputations(graph, "d", "x+3+x*2", 2);
+    missmatch |= checkRecomputations(graph, "c", "x*2", 0);
+    missmatch |= checkRecomputations(graph, "f", "y", 0);
+
+    // both paths of the diamond are invalidated
+    graph.define("a", Parser::parse("z"));
+    missmatch |= checkRecomputations(graph, "d", "z+3+z*2", 4);
+    missmatch |= checkRecomputations(graph, "f", "y", 0);
+
+    // a cycle through the diamond is rejected and the graph is unchanged
+    try {
+        graph.define("a", Parser::parse("d"));
+        std::cout << "a definition depending on itself through a diamond was accepted" << std::endl;
+        missmatch = true;
+    }
+    catch (const std::runtime_error&) {
+    }
+    missmatch |= checkRecomputations(graph, "d", "z+3+z*2", 0);
+    missmatch |= checkRecomputations(graph, "a", "z", 0);
+
+    // a long chain of diamonds is checked without visiting every path
+    VariableGraph chain;
+    const std::string symbols = "abcdfghjklmnopqrstuvw";
+    chain.define("A", Parser::parse("x"));
+    chain.define("a", Parser::parse("x"));
+    for (size_t i = 1; i < symbols.size(); i++) {
+        const std::string previous = std::string(1, std::toupper(symbols[i - 1])) + "+" + symbols[i - 1];
+        chain.define(std::string(1, std::toupper(symbols[i])), Parser::parse(previous));
+        chain.define(std::string(1, symbols[i]), Parser::parse(previous));
+    }
+
+    try {
+        chain.define("x", Parser::parse("W+w"));
+        std::cout << "a cycle through a chain of diamonds was accepted" << std::endl;
+        missmatch = true;
+    }
+    catch (const std::runtime_error&) {
+    }
+    chain.define("y", Parser::parse("W+w"));
+
+    // cyclic definitions are rejected by the engine and the old values stay
+    Engine engine;
+    execute(engine, "a=1");
+    execute(engine, "b=a+1");
+    missmatch |= checkOutput(engine, "a=b", "The definition of a depends on a itself\n");
+    missmatch |= checkOutput(engine, "set[a, b*2]", "The definition of a depends on a itself\n");
+    missmatch |= checkOutput(engine, "a", "1\n");
+    missmatch |= checkOutput(engine, "b", "1+1\n");
+
+    execute(engine, "f=g");
+    missmatch |= checkOutput(engine, "g=f", "The definition of g depends on g itself\n");
+    missmatch |= checkOutput(engine, "f", "g\n");
+    missmatch |= checkOutput(engine, "g", "Command \"g\" not found!\n");
+
+    // the dependents are listed in topological order
+    execute(engine, "c=a*2");
+    execute(engine, "d=b+c");
+    missmatch |= checkOutput(engine, "dependents[a]", "c, b, d\n");
+    missmatch |= checkOutput(engine, "dependents[b]", "d\n");
+    missmatch |= checkOutput(engine, "dependents[d]", "No variable depends on d\n");
+    missmatch |= checkOutput(engine, "dependents[h]", "Variable h is not defined\n");
+
+    return missmatch;
+}